@@ -0,0 +1,203 @@
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <new>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "hierarchy/polygon.h"
+#include "hierarchy/point.h"
+#include "hierarchy/line.h"
+#include "hierarchy/rectangle.h"
+#include "hierarchy/triangle.h"
+#include "hierarchy/circle.h"
+#include "hierarchy/ellipse.h"
+#include "hierarchy/square.h"
+
+// Бенчмарк методов иерархии: для каждого числа вершин печатает ns/op и
+// число аллокаций на операцию. Генераторы детерминированы (фиксированный seed),
+// поэтому результаты разных запусков сравнимы между собой.
+
+static std::size_t allocations = 0;
+
+void* operator new(std::size_t size) {
+    ++allocations;
+    if (void* ptr = std::malloc(size == 0 ? 1 : size)) {
+        return ptr;
+    }
+    throw std::bad_alloc();
+}
+
+void operator delete(void* ptr) noexcept {
+    std::free(ptr);
+}
+
+void operator delete(void* ptr, std::size_t) noexcept {
+    std::free(ptr);
+}
+
+const double kPi = 3.1415926;
+const std::uint32_t kSeed = 20201018;
+
+// не даем компилятору выбросить вызовы, результат которых не используется
+static volatile double sink = 0;
+
+std::vector<double> RandomAngles(std::mt19937& gen, std::size_t count) {
+    std::uniform_real_distribution<double> dist(0, 2 * kPi);
+    std::vector<double> angles(count);
+    for (double& angle : angles) {
+        angle = dist(gen);
+    }
+    std::sort(angles.begin(), angles.end());
+    return angles;
+}
+
+// вершины на окружности, упорядоченные по углу, - выпуклый многоугольник
+std::vector<Point> ConvexPolygon(std::mt19937& gen, std::size_t count) {
+    std::vector<Point> vertices;
+    for (double angle : RandomAngles(gen, count)) {
+        vertices.emplace_back(100 * std::cos(angle), 100 * std::sin(angle));
+    }
+    return vertices;
+}
+
+// "звезда": случайный радиус у каждой вершины дает невыпуклый простой многоугольник
+std::vector<Point> StarPolygon(std::mt19937& gen, std::size_t count) {
+    std::uniform_real_distribution<double> radius(20, 100);
+    std::vector<Point> vertices;
+    for (double angle : RandomAngles(gen, count)) {
+        double r = radius(gen);
+        vertices.emplace_back(r * std::cos(angle), r * std::sin(angle));
+    }
+    return vertices;
+}
+
+Ellipse RandomEllipse(std::mt19937& gen) {
+    std::uniform_real_distribution<double> coord(-100, 100);
+    Point first(coord(gen), coord(gen));
+    Point second(coord(gen), coord(gen));
+    return Ellipse(first, second, 2 * (std::hypot(first.x - second.x, first.y - second.y) + 1));
+}
+
+std::vector<Point> RandomPoints(std::mt19937& gen, std::size_t count) {
+    std::uniform_real_distribution<double> coord(-120, 120);
+    std::vector<Point> points;
+    for (std::size_t i = 0; i < count; i++) {
+        points.emplace_back(coord(gen), coord(gen));
+    }
+    return points;
+}
+
+template<typename F>
+void Report(const std::string& shape, std::size_t vertices, const std::string& method, F op,
+            std::size_t iterations) {
+    op();
+    std::size_t allocations_before = allocations;
+    auto start = std::chrono::steady_clock::now();
+    for (std::size_t i = 0; i < iterations; i++) {
+        op();
+    }
+    auto finish = std::chrono::steady_clock::now();
+    double ns = std::chrono::duration<double, std::nano>(finish - start).count();
+    std::cout << std::left << std::setw(10) << shape
+              << std::setw(10) << vertices
+              << std::setw(16) << method
+              << std::setw(14) << std::fixed << std::setprecision(1) << ns / iterations
+              << double(allocations - allocations_before) / iterations << std::endl;
+}
+
+// все методы Shape, которые можно вызвать у многоугольника
+void BenchPolygon(const std::string& name, const std::vector<Point>& vertices, std::mt19937& gen) {
+    std::size_t n = vertices.size();
+    std::size_t iterations = std::max<std::size_t>(10, 2000000 / n);
+
+    Polygon poly(vertices);
+    Polygon same(vertices);
+    std::vector<Point> shifted(vertices.begin() + n / 2, vertices.end());
+    shifted.insert(shifted.end(), vertices.begin(), vertices.begin() + n / 2);
+    Polygon rotated_order(shifted);
+    std::vector<Point> queries = RandomPoints(gen, 1024);
+    std::size_t query = 0;
+    Point origin(0, 0);
+    Line axis(origin, Point(1, 1));
+    double coefficient = 2;
+
+    Report(name, n, "perimeter", [&] { sink = sink + poly.perimeter(); }, iterations);
+    Report(name, n, "area", [&] { sink = sink + poly.area(); }, iterations);
+    Report(name, n, "isConvex", [&] { sink = sink + poly.isConvex(); }, iterations);
+    Report(name, n, "containsPoint", [&] {
+        sink = sink + poly.containsPoint(queries[query++ % queries.size()]);
+    }, iterations);
+    Report(name, n, "operator==", [&] { sink = sink + (poly == rotated_order); }, iterations);
+    Report(name, n, "isCongruentTo", [&] { sink = sink + poly.isCongruentTo(same); },
+           std::max<std::size_t>(1, iterations / n));
+    Report(name, n, "isSimilarTo", [&] { sink = sink + poly.isSimilarTo(same); },
+           std::max<std::size_t>(1, iterations / n));
+    Report(name, n, "rotate", [&] { poly.rotate(origin, 1); }, iterations);
+    Report(name, n, "reflex(Point)", [&] { poly.reflex(origin); }, iterations);
+    Report(name, n, "reflex(Line)", [&] { poly.reflex(axis); }, iterations);
+    Report(name, n, "scale", [&] {
+        poly.scale(origin, coefficient);
+        coefficient = 1 / coefficient;
+    }, iterations);
+    Report(name, n, "chain", [&] {
+        poly.rotate(origin, 30);
+        poly.scale(origin, 3);
+        poly.reflex(axis);
+        poly.scale(origin, 1.0 / 3);
+        poly.reflex(origin);
+    }, iterations);
+}
+
+void BenchEllipse(std::mt19937& gen) {
+    const std::size_t iterations = 1000000;
+    Ellipse ellipse = RandomEllipse(gen);
+    Ellipse same = ellipse;
+    std::vector<Point> queries = RandomPoints(gen, 1024);
+    std::size_t query = 0;
+    Point origin(0, 0);
+    Line axis(origin, Point(1, 1));
+
+    Report("ellipse", 0, "perimeter", [&] { sink = sink + ellipse.perimeter(); }, iterations);
+    Report("ellipse", 0, "area", [&] { sink = sink + ellipse.area(); }, iterations);
+    Report("ellipse", 0, "eccentricity", [&] { sink = sink + ellipse.eccentricity(); }, iterations);
+    Report("ellipse", 0, "containsPoint", [&] {
+        sink = sink + ellipse.containsPoint(queries[query++ % queries.size()]);
+    }, iterations);
+    Report("ellipse", 0, "isCongruentTo", [&] { sink = sink + ellipse.isCongruentTo(same); }, iterations);
+    Report("ellipse", 0, "chain", [&] {
+        ellipse.rotate(origin, 30);
+        ellipse.scale(origin, 3);
+        ellipse.reflex(axis);
+        ellipse.scale(origin, 1.0 / 3);
+        ellipse.reflex(origin);
+    }, iterations);
+}
+
+int main(int argc, char** argv) {
+    std::size_t max_vertices = argc > 1 ? std::stoul(argv[1]) : 100000;
+    std::mt19937 gen(kSeed);
+
+    std::cout << std::left << std::setw(10) << "shape" << std::setw(10) << "vertices"
+              << std::setw(16) << "method" << std::setw(14) << "ns/op" << "allocs/op" << std::endl;
+
+    // 4, 16, 64, ... и последним шагом сам max_vertices
+    std::vector<std::size_t> sizes;
+    for (std::size_t n = 4; n < max_vertices; n *= 4) {
+        sizes.push_back(n);
+    }
+    if (max_vertices >= 4) {
+        sizes.push_back(max_vertices);
+    }
+    for (std::size_t n : sizes) {
+        BenchPolygon("convex", ConvexPolygon(gen, n), gen);
+        BenchPolygon("star", StarPolygon(gen, n), gen);
+    }
+    BenchEllipse(gen);
+    return 0;
+}
@@ -0,0 +1,156 @@
+#include <sys/resource.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <chrono>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+// Замер времени компиляции метафункций TypeList в зависимости от длины списка.
+// Для каждой пары (операция, длина) генерируется исходник, который только
+// инстанцирует операцию, и компилируется отдельным процессом компилятора.
+// Из времени и памяти вычитается "пустой" исходник, который строит тот же список.
+//
+// Запуск: compile_bench <рабочая директория> [флаги компилятора...]
+// CXX_COMPILER и TYPELIST_DIR подставляет CMake.
+
+const int kRepeats = 3;
+
+struct Operation {
+    std::string name;
+    std::string header;
+    std::string body;
+};
+
+struct Measurement {
+    bool ok;
+    double ms;
+    long max_rss_kb;
+};
+
+// список длины length из типов T<i % distinct>: дубликаты нужны для NoDuplicates и EraseAll
+std::string MakeList(int length, int distinct) {
+    std::ostringstream list;
+    for (int i = 0; i < length; i++) {
+        list << "TypeList<T<" << i % distinct << ">, ";
+    }
+    list << "NullType";
+    for (int i = 0; i < length; i++) {
+        list << ">";
+    }
+    return list.str();
+}
+
+std::string MakeSource(const Operation& operation, int length) {
+    std::ostringstream source;
+    source << "#include \"" << operation.header << "\"\n\n"
+           << "template<int> struct T {};\n\n"
+           << "typedef " << MakeList(length, length / 2 + 1) << " List;\n\n"
+           << operation.body << "\n\n"
+           << "int main() { return 0; }\n";
+    return source.str();
+}
+
+// компилятор запускается через fork/exec, чтобы wait4 вернул память именно этого процесса.
+// Компилируем в объектный файл, а не с -fsyntax-only: Clang кладет отчет -ftime-trace
+// рядом с выходным файлом, и без него отчета нет. Кодогенерация пустого main
+// одинакова у всех исходников и вычитается вместе с базовым замером
+Measurement Compile(const std::string& path, const std::vector<std::string>& flags, int length) {
+    std::string object = path.substr(0, path.rfind('.')) + ".o";
+    std::vector<std::string> args = {CXX_COMPILER, "-std=c++17", "-c", "-o", object,
+                                     "-ftemplate-depth=" + std::to_string(4 * length + 1024),
+                                     "-I", TYPELIST_DIR};
+    args.insert(args.end(), flags.begin(), flags.end());
+    args.push_back(path);
+
+    std::vector<char*> argv;
+    for (std::string& arg : args) {
+        argv.push_back(&arg[0]);
+    }
+    argv.push_back(nullptr);
+
+    auto start = std::chrono::steady_clock::now();
+    pid_t pid = fork();
+    if (pid < 0) {
+        std::cerr << "fork: " << std::strerror(errno) << std::endl;
+        return {false, 0, 0};
+    }
+    if (pid == 0) {
+        execv(argv[0], argv.data());
+        _exit(127);
+    }
+
+    int status = 0;
+    struct rusage usage = {};
+    wait4(pid, &status, 0, &usage);
+    auto finish = std::chrono::steady_clock::now();
+
+    return {WIFEXITED(status) && WEXITSTATUS(status) == 0,
+            std::chrono::duration<double, std::milli>(finish - start).count(),
+            usage.ru_maxrss};
+}
+
+int main(int argc, char** argv) {
+    if (argc < 2) {
+        std::cerr << "usage: " << argv[0] << " <work dir> [compiler flags...]" << std::endl;
+        return 1;
+    }
+    std::string work_dir = argv[1];
+    std::vector<std::string> flags(argv + 2, argv + argc);
+
+    const std::vector<int> lengths = {10, 50, 100, 250, 500, 1000, 2000};
+    const std::vector<Operation> operations = {
+        {"Baseline", "typelist.h", "typedef List Result;"},
+        {"IndexOf", "indexof.h", "static_assert(IndexOf<List, T<-1>>::pos == -1, \"\");"},
+        {"Replace", "replace.h", "typedef Replace<List, T<-1>, int>::NewTypeList Result;"},
+        {"EraseAll", "eraseall.h", "typedef EraseAll<List, T<0>>::NewTypeList Result;"},
+        {"NoDuplicates", "noduplicates.h", "typedef NoDuplicates<List>::NewTypeList Result;"},
+    };
+
+    std::ofstream report(work_dir + "/compile_bench.csv");
+    report << "operation,length,ms,max_rss_kb,ms_over_baseline,rss_over_baseline_kb\n";
+
+    std::cout << std::left << std::setw(14) << "operation" << std::setw(8) << "length"
+              << std::setw(12) << "ms" << std::setw(14) << "max rss, KB"
+              << std::setw(14) << "ms - base" << "KB - base" << std::endl;
+
+    for (int length : lengths) {
+        Measurement baseline = {};
+        for (const Operation& operation : operations) {
+            std::string path = work_dir + "/" + operation.name + "_" + std::to_string(length) + ".cpp";
+            std::ofstream(path) << MakeSource(operation, length);
+
+            // быстрые замеры шумные: берем минимум из нескольких запусков
+            Measurement result = Compile(path, flags, length);
+            for (int repeat = 1; repeat < kRepeats && result.ok && result.ms < 1000; repeat++) {
+                Measurement another = Compile(path, flags, length);
+                if (another.ms < result.ms) {
+                    result = another;
+                }
+            }
+            if (operation.name == "Baseline") {
+                baseline = result;
+            }
+
+            std::cout << std::left << std::setw(14) << operation.name << std::setw(8) << length;
+            if (!result.ok) {
+                std::cout << "compilation failed" << std::endl;
+                report << operation.name << "," << length << ",,,,\n";
+                continue;
+            }
+            std::cout << std::setw(12) << std::fixed << std::setprecision(1) << result.ms
+                      << std::setw(14) << result.max_rss_kb
+                      << std::setw(14) << result.ms - baseline.ms
+                      << result.max_rss_kb - baseline.max_rss_kb << std::endl;
+            report << operation.name << "," << length << "," << result.ms << "," << result.max_rss_kb
+                   << "," << result.ms - baseline.ms << "," << result.max_rss_kb - baseline.max_rss_kb << "\n";
+        }
+    }
+    return 0;
+}
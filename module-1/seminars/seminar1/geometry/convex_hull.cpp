@@ -0,0 +1,217 @@
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <iostream>
+#include <random>
+#include <vector>
+
+// Выпуклая оболочка и быстрые запросы к выпуклому многоугольнику:
+// * ConvexHull - монотонная цепочка Эндрю, O(n log n), вершины против часовой стрелки
+// * ConvexContains - принадлежность точки за O(log n): бинпоиск по "вееру"
+//   треугольников из первой вершины вместо обхода всех ребер
+// * Diameter / Width - вращающиеся калиперы, O(h) по h вершинам оболочки
+// Точка - простая структура: сюда подставятся Point и Polygon из homework/Geometry,
+// когда иерархия будет реализована.
+
+struct Point {
+    double x;
+    double y;
+};
+
+bool operator<(const Point& lhs, const Point& rhs) {
+    return lhs.x < rhs.x || (lhs.x == rhs.x && lhs.y < rhs.y);
+}
+
+bool operator==(const Point& lhs, const Point& rhs) {
+    return lhs.x == rhs.x && lhs.y == rhs.y;
+}
+
+// > 0, если поворот o -> a -> b против часовой стрелки
+double Cross(const Point& o, const Point& a, const Point& b) {
+    return (a.x - o.x) * (b.y - o.y) - (a.y - o.y) * (b.x - o.x);
+}
+
+double Distance(const Point& a, const Point& b) {
+    return std::hypot(a.x - b.x, a.y - b.y);
+}
+
+// нижняя цепочка слева направо, затем верхняя справа налево;
+// точки на ребрах оболочки отбрасываются
+std::vector<Point> ConvexHull(std::vector<Point> points) {
+    std::sort(points.begin(), points.end());
+    points.erase(std::unique(points.begin(), points.end()), points.end());
+    if (points.size() < 3) {
+        return points;
+    }
+
+    std::vector<Point> hull(2 * points.size());
+    std::size_t size = 0;
+    for (std::size_t i = 0; i < points.size(); i++) {
+        while (size >= 2 && Cross(hull[size - 2], hull[size - 1], points[i]) <= 0) {
+            --size;
+        }
+        hull[size++] = points[i];
+    }
+    for (std::size_t i = points.size() - 1, lower = size + 1; i-- > 0;) {
+        while (size >= lower && Cross(hull[size - 2], hull[size - 1], points[i]) <= 0) {
+            --size;
+        }
+        hull[size++] = points[i];
+    }
+    // последняя точка верхней цепочки совпадает с первой
+    hull.resize(size - 1);
+    return hull;
+}
+
+// hull - выпуклый многоугольник против часовой стрелки, не меньше 3 вершин.
+// Лучи hull[0] -> hull[i] делят его на треугольники; бинпоиском находим
+// сектор, в который попал луч hull[0] -> p, и проверяем одну сторону
+bool ConvexContains(const std::vector<Point>& hull, const Point& p) {
+    std::size_t n = hull.size();
+    if (Cross(hull[0], hull[1], p) < 0 || Cross(hull[0], hull[n - 1], p) > 0) {
+        return false;
+    }
+    std::size_t lo = 1;
+    std::size_t hi = n - 1;
+    while (hi - lo > 1) {
+        std::size_t mid = (lo + hi) / 2;
+        if (Cross(hull[0], hull[mid], p) >= 0) {
+            lo = mid;
+        } else {
+            hi = mid;
+        }
+    }
+    return Cross(hull[lo], hull[lo + 1], p) >= 0;
+}
+
+// то же за O(n): точка лежит слева от каждого ребра или на нем
+bool LinearContains(const std::vector<Point>& hull, const Point& p) {
+    for (std::size_t i = 0; i < hull.size(); i++) {
+        if (Cross(hull[i], hull[(i + 1) % hull.size()], p) < 0) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// Для каждого ребра i -> i + 1 калипер j - самая далекая от него вершина;
+// при движении по ребрам j тоже движется только вперед, поэтому проход линейный.
+// Диаметр - максимум расстояний от концов ребра до j,
+// ширина - минимум расстояния от ребра до j
+struct Calipers {
+    double diameter;
+    double width;
+};
+
+Calipers RotatingCalipers(const std::vector<Point>& hull) {
+    std::size_t n = hull.size();
+    Calipers result = {0, INFINITY};
+    if (n < 3) {
+        result.diameter = n == 2 ? Distance(hull[0], hull[1]) : 0;
+        result.width = 0;
+        return result;
+    }
+    std::size_t j = 1;
+    for (std::size_t i = 0; i < n; i++) {
+        const Point& a = hull[i];
+        const Point& b = hull[(i + 1) % n];
+        while (Cross(a, b, hull[(j + 1) % n]) > Cross(a, b, hull[j])) {
+            j = (j + 1) % n;
+        }
+        result.diameter = std::max({result.diameter, Distance(a, hull[j]), Distance(b, hull[j])});
+        result.width = std::min(result.width, Cross(a, b, hull[j]) / Distance(a, b));
+    }
+    return result;
+}
+
+// проверка калиперов перебором всех пар, O(h^2)
+Calipers BruteForceCalipers(const std::vector<Point>& hull) {
+    Calipers result = {0, INFINITY};
+    for (std::size_t i = 0; i < hull.size(); i++) {
+        const Point& a = hull[i];
+        const Point& b = hull[(i + 1) % hull.size()];
+        double farthest = 0;
+        for (const Point& p : hull) {
+            result.diameter = std::max(result.diameter, Distance(a, p));
+            farthest = std::max(farthest, Cross(a, b, p) / Distance(a, b));
+        }
+        result.width = std::min(result.width, farthest);
+    }
+    return result;
+}
+
+template<typename F>
+auto Measure(const char* name, std::size_t count, F f) {
+    auto start = std::chrono::steady_clock::now();
+    auto result = f();
+    auto finish = std::chrono::steady_clock::now();
+    std::cout << name << ": " << std::chrono::duration<double, std::nano>(finish - start).count() / count
+              << " ns/op" << std::endl;
+    return result;
+}
+
+int main() {
+    const std::size_t count = 1000000;
+    const std::size_t queries = 1000000;
+    std::mt19937 gen(42);
+
+    // точки в круге: оболочка - порядка n^(1/3) вершин; точки на окружности - все n
+    std::uniform_real_distribution<double> unit(-1, 1);
+    std::vector<Point> disk;
+    while (disk.size() < count) {
+        Point p = {unit(gen), unit(gen)};
+        if (p.x * p.x + p.y * p.y <= 1) {
+            disk.push_back(p);
+        }
+    }
+    std::uniform_real_distribution<double> angle(0, 2 * 3.14159265358979323846);
+    std::vector<Point> circle(count);
+    for (Point& p : circle) {
+        double phi = angle(gen);
+        p = {std::cos(phi), std::sin(phi)};
+    }
+
+    std::vector<Point> disk_hull = Measure("hull of 10^6 points in a disk", count, [&] {
+        return ConvexHull(disk);
+    });
+    std::vector<Point> hull = Measure("hull of 10^6 points on a circle", count, [&] {
+        return ConvexHull(circle);
+    });
+    std::cout << "hull sizes: " << disk_hull.size() << " " << hull.size() << std::endl;
+
+    std::vector<Point> query_points(queries);
+    for (Point& p : query_points) {
+        p = {1.1 * unit(gen), 1.1 * unit(gen)};
+    }
+    std::size_t inside_log = Measure("ConvexContains, O(log n)", queries, [&] {
+        std::size_t inside = 0;
+        for (const Point& p : query_points) {
+            inside += ConvexContains(hull, p);
+        }
+        return inside;
+    });
+    // линейный обход слишком долгий на всех запросах, берем тысячную часть
+    std::size_t inside_linear = Measure("LinearContains, O(n)", queries / 1000, [&] {
+        std::size_t inside = 0;
+        for (std::size_t i = 0; i < queries / 1000; i++) {
+            inside += LinearContains(hull, query_points[i]);
+        }
+        return inside;
+    });
+    std::size_t inside_check = 0;
+    for (std::size_t i = 0; i < queries / 1000; i++) {
+        inside_check += ConvexContains(hull, query_points[i]);
+    }
+    std::cout << "inside: " << inside_log << ", first 1000: " << inside_check << " " << inside_linear << std::endl;
+
+    Calipers calipers = Measure("rotating calipers", hull.size(), [&] {
+        return RotatingCalipers(hull);
+    });
+    Calipers brute = BruteForceCalipers(disk_hull);
+    Calipers fast = RotatingCalipers(disk_hull);
+    std::cout << "circle hull: diameter " << calipers.diameter << " width " << calipers.width << std::endl;
+    std::cout << "disk hull: diameter " << fast.diameter << " / " << brute.diameter << " width " << fast.width
+              << " / " << brute.width << std::endl;
+    return 0;
+}
@@ -0,0 +1,270 @@
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <vector>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define ELLIPSE_HAVE_AVX2 1
+#else
+#define ELLIPSE_HAVE_AVX2 0
+#endif
+
+// Ядра для эллипса, заданного как в homework/Geometry: два фокуса и сумма расстояний до них.
+// * AgmPerimeter - периметр через арифметико-геометрическое среднее (Гаусс-Куммер):
+//   AGM сходится квадратично, полная точность double - за 4-6 итераций
+// * Frame - канонический базис эллипса (центр, направление большой оси, 1 / a^2, 1 / b^2),
+//   считается один раз; принадлежность точки - квадратичная форма без sqrt
+// * ContainsPoints - то же для массива точек: переносимо и на AVX2 по 4 точки,
+//   реализация выбирается при запуске по __builtin_cpu_supports
+// Когда иерархия будет реализована, Ellipse::perimeter и containsPoint смогут звать эти ядра.
+
+const double kPi = 3.14159265358979323846;
+
+struct Point {
+    double x;
+    double y;
+};
+
+struct Ellipse {
+    Point first;
+    Point second;
+    double distance_sum;
+};
+
+double SemiMajor(const Ellipse& e) {
+    return e.distance_sum / 2;
+}
+
+double SemiMinor(const Ellipse& e) {
+    double a = SemiMajor(e);
+    double c = std::hypot(e.first.x - e.second.x, e.first.y - e.second.y) / 2;
+    return std::sqrt(std::max(0.0, (a - c) * (a + c)));
+}
+
+// P = 2 pi / AGM(a, b) * (a^2 - sum 2^(n - 1) c_n^2), c_0^2 = a^2 - b^2, c_(n+1) = (a_n - b_n) / 2
+double AgmPerimeter(double a, double b) {
+    if (b == 0) {
+        return 4 * a;
+    }
+    double power = 0.5;
+    double sum = power * (a - b) * (a + b);
+    double an = a;
+    double bn = b;
+    while (an - bn > 1e-15 * an) {
+        double cn = (an - bn) / 2;
+        double next = (an + bn) / 2;
+        bn = std::sqrt(an * bn);
+        an = next;
+        power *= 2;
+        sum += power * cn * cn;
+    }
+    return 2 * kPi * (a * a - sum) / (an + bn) * 2;
+}
+
+// для сравнения: приближение Рамануджана и формула Симпсона по четверти эллипса
+double RamanujanPerimeter(double a, double b) {
+    double h = (a - b) * (a - b) / ((a + b) * (a + b));
+    return kPi * (a + b) * (1 + 3 * h / (10 + std::sqrt(4 - 3 * h)));
+}
+
+double SimpsonPerimeter(double a, double b, int segments) {
+    double step = kPi / 2 / segments;
+    double sum = 0;
+    for (int i = 0; i <= segments; i++) {
+        double t = i * step;
+        double value = std::sqrt(a * a * std::sin(t) * std::sin(t) + b * b * std::cos(t) * std::cos(t));
+        sum += value * (i == 0 || i == segments ? 1 : (i % 2 ? 4 : 2));
+    }
+    return 4 * sum * step / 3;
+}
+
+// эталон: формула трапеций для периодической функции сходится экспоненциально
+long double ReferencePerimeter(long double a, long double b) {
+    const int points = 1 << 16;
+    long double sum = 0;
+    for (int i = 0; i < points; i++) {
+        long double t = 2 * 3.14159265358979323846264338327950288L * i / points;
+        sum += std::sqrt(a * a * std::sin(t) * std::sin(t) + b * b * std::cos(t) * std::cos(t));
+    }
+    return sum * 2 * 3.14159265358979323846264338327950288L / points;
+}
+
+// как обычно пишут containsPoint: два sqrt на запрос
+bool NaiveContains(const Ellipse& e, const Point& p) {
+    return std::hypot(p.x - e.first.x, p.y - e.first.y) + std::hypot(p.x - e.second.x, p.y - e.second.y)
+           <= e.distance_sum;
+}
+
+struct Frame {
+    double cx;
+    double cy;
+    double cos;
+    double sin;
+    double inv_a2;
+    double inv_b2;
+};
+
+Frame MakeFrame(const Ellipse& e) {
+    Frame frame;
+    frame.cx = (e.first.x + e.second.x) / 2;
+    frame.cy = (e.first.y + e.second.y) / 2;
+    double length = std::hypot(e.second.x - e.first.x, e.second.y - e.first.y);
+    // у круга фокусы совпадают, направление любое
+    frame.cos = length > 0 ? (e.second.x - e.first.x) / length : 1;
+    frame.sin = length > 0 ? (e.second.y - e.first.y) / length : 0;
+    double a = SemiMajor(e);
+    double b = SemiMinor(e);
+    frame.inv_a2 = 1 / (a * a);
+    frame.inv_b2 = 1 / (b * b);
+    return frame;
+}
+
+// (u / a)^2 + (v / b)^2 <= 1 в координатах вдоль осей эллипса
+bool FrameContains(const Frame& f, double x, double y) {
+    double dx = x - f.cx;
+    double dy = y - f.cy;
+    double u = dx * f.cos + dy * f.sin;
+    double v = dy * f.cos - dx * f.sin;
+    return u * u * f.inv_a2 + v * v * f.inv_b2 <= 1;
+}
+
+namespace portable {
+    void ContainsPoints(const Frame& f, const double* xs, const double* ys, std::size_t size, std::uint8_t* out) {
+        for (std::size_t i = 0; i < size; i++) {
+            out[i] = FrameContains(f, xs[i], ys[i]);
+        }
+    }
+}
+
+#if ELLIPSE_HAVE_AVX2
+namespace avx2 {
+    // те же операции в том же порядке, что FrameContains, поэтому ответы совпадают побитно
+    __attribute__((target("avx2")))
+    void ContainsPoints(const Frame& f, const double* xs, const double* ys, std::size_t size, std::uint8_t* out) {
+        const __m256d cx = _mm256_set1_pd(f.cx);
+        const __m256d cy = _mm256_set1_pd(f.cy);
+        const __m256d cos = _mm256_set1_pd(f.cos);
+        const __m256d sin = _mm256_set1_pd(f.sin);
+        const __m256d inv_a2 = _mm256_set1_pd(f.inv_a2);
+        const __m256d inv_b2 = _mm256_set1_pd(f.inv_b2);
+        const __m256d one = _mm256_set1_pd(1);
+        std::size_t i = 0;
+        for (; i + 4 <= size; i += 4) {
+            __m256d dx = _mm256_sub_pd(_mm256_loadu_pd(xs + i), cx);
+            __m256d dy = _mm256_sub_pd(_mm256_loadu_pd(ys + i), cy);
+            __m256d u = _mm256_add_pd(_mm256_mul_pd(dx, cos), _mm256_mul_pd(dy, sin));
+            __m256d v = _mm256_sub_pd(_mm256_mul_pd(dy, cos), _mm256_mul_pd(dx, sin));
+            __m256d form = _mm256_add_pd(_mm256_mul_pd(_mm256_mul_pd(u, u), inv_a2),
+                                         _mm256_mul_pd(_mm256_mul_pd(v, v), inv_b2));
+            int mask = _mm256_movemask_pd(_mm256_cmp_pd(form, one, _CMP_LE_OQ));
+            for (int lane = 0; lane < 4; lane++) {
+                out[i + lane] = (mask >> lane) & 1;
+            }
+        }
+        portable::ContainsPoints(f, xs + i, ys + i, size - i, out + i);
+    }
+}
+#endif
+
+typedef void (*ContainsFunction)(const Frame&, const double*, const double*, std::size_t, std::uint8_t*);
+
+ContainsFunction Detect() {
+#if ELLIPSE_HAVE_AVX2
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2")) {
+        return &avx2::ContainsPoints;
+    }
+#endif
+    return &portable::ContainsPoints;
+}
+
+const ContainsFunction kContainsPoints = Detect();
+
+template<typename F>
+auto Measure(const char* name, std::size_t count, F f) {
+    auto start = std::chrono::steady_clock::now();
+    auto result = f();
+    auto finish = std::chrono::steady_clock::now();
+    std::cout << name << ": " << std::chrono::duration<double, std::nano>(finish - start).count() / count
+              << " ns/op" << std::endl;
+    return result;
+}
+
+int main() {
+    std::cout << "relative error, b / a: agm, ramanujan, simpson(1000)" << std::endl;
+    for (double ratio : {1.0, 0.9, 0.5, 0.1, 1e-2, 1e-3}) {
+        long double reference = ReferencePerimeter(1, ratio);
+        std::cout << std::setprecision(3) << ratio << ": "
+                  << std::fabs(AgmPerimeter(1, ratio) - reference) / reference << " "
+                  << std::fabs(RamanujanPerimeter(1, ratio) - reference) / reference << " "
+                  << std::fabs(SimpsonPerimeter(1, ratio, 1000) - reference) / reference << std::endl;
+    }
+
+    const std::size_t count = 1000000;
+    std::mt19937 gen(42);
+    std::uniform_real_distribution<double> coord(-100, 100);
+    std::vector<double> axes(count);
+    for (double& axis : axes) {
+        axis = std::fabs(coord(gen)) + 1e-3;
+    }
+    double agm = Measure("AgmPerimeter", count, [&] {
+        double sum = 0;
+        for (std::size_t i = 0; i < count; i++) {
+            sum += AgmPerimeter(100, axes[i]);
+        }
+        return sum;
+    });
+    double simpson = Measure("SimpsonPerimeter(1000)", count / 1000, [&] {
+        double sum = 0;
+        for (std::size_t i = 0; i < count / 1000; i++) {
+            sum += SimpsonPerimeter(100, axes[i], 1000);
+        }
+        return sum;
+    });
+
+    Point first = {coord(gen), coord(gen)};
+    Point second = {coord(gen), coord(gen)};
+    Ellipse ellipse = {first, second, 2 * (std::hypot(first.x - second.x, first.y - second.y) / 2 + 30)};
+    Frame frame = MakeFrame(ellipse);
+    std::vector<double> xs(count);
+    std::vector<double> ys(count);
+    for (std::size_t i = 0; i < count; i++) {
+        xs[i] = coord(gen);
+        ys[i] = coord(gen);
+    }
+    std::vector<std::uint8_t> naive(count);
+    std::vector<std::uint8_t> scalar(count);
+    std::vector<std::uint8_t> batched(count);
+
+    Measure("naive containsPoint, 2 sqrt", count, [&] {
+        for (std::size_t i = 0; i < count; i++) {
+            naive[i] = NaiveContains(ellipse, {xs[i], ys[i]});
+        }
+        return 0;
+    });
+    Measure("frame containsPoint", count, [&] {
+        portable::ContainsPoints(frame, xs.data(), ys.data(), count, scalar.data());
+        return 0;
+    });
+    Measure("batched containsPoints", count, [&] {
+        kContainsPoints(frame, xs.data(), ys.data(), count, batched.data());
+        return 0;
+    });
+
+    std::size_t inside = std::count(scalar.begin(), scalar.end(), 1);
+    std::size_t disagree = 0;
+    for (std::size_t i = 0; i < count; i++) {
+        disagree += naive[i] != scalar[i];
+    }
+    // расхождения с наивной проверкой возможны только у точек на самой границе
+    std::cout << "inside: " << inside << ", naive disagrees: " << disagree
+              << ", batched " << (batched == scalar ? "matches" : "differs") << std::endl;
+    std::cout << "checksum: " << agm << " " << simpson << std::endl;
+    return 0;
+}
@@ -0,0 +1,234 @@
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+#include <random>
+#include <thread>
+#include <vector>
+
+// Принадлежность многих точек одному простому многоугольнику:
+// * RayCastContains - обычный containsPoint: луч вправо и четность пересечений, O(n) на точку
+// * SlabIndex - разбиение на горизонтальные полосы по y-координатам вершин. Внутри полосы
+//   ребра не пересекаются, поэтому их можно упорядочить по x один раз; запрос - бинпоиск
+//   полосы и бинпоиск по ребрам полосы, O(log n). Памяти - суммарное число ребер по полосам:
+//   O(n) для почти выпуклых многоугольников, до O(n^2) для "ежей"
+// * ContainsPoints - пакетный запрос, точки делятся на куски между потоками
+// Ответы по построению совпадают с RayCastContains, включая точки на границе.
+// Когда иерархия будет реализована, Polygon сможет строить индекс для пакетных запросов.
+
+struct Point {
+    double x;
+    double y;
+};
+
+// правило полуоткрытого ребра: ребро считается, если p.y в [min y, max y) его концов;
+// горизонтальные ребра не считаются никогда
+bool Crosses(const Point& a, const Point& b, const Point& p) {
+    return (a.y > p.y) != (b.y > p.y);
+}
+
+// x точки ребра на высоте y; одна и та же формула в обоих методах, чтобы ответы совпадали
+double EdgeX(const Point& a, const Point& b, double y) {
+    return a.x + (y - a.y) * (b.x - a.x) / (b.y - a.y);
+}
+
+bool RayCastContains(const std::vector<Point>& polygon, const Point& p) {
+    bool inside = false;
+    for (std::size_t i = 0, j = polygon.size() - 1; i < polygon.size(); j = i++) {
+        if (Crosses(polygon[j], polygon[i], p) && p.x < EdgeX(polygon[j], polygon[i], p.y)) {
+            inside = !inside;
+        }
+    }
+    return inside;
+}
+
+class SlabIndex {
+public:
+    explicit SlabIndex(const std::vector<Point>& polygon) : polygon_(polygon) {
+        for (const Point& p : polygon) {
+            ys_.push_back(p.y);
+        }
+        std::sort(ys_.begin(), ys_.end());
+        ys_.erase(std::unique(ys_.begin(), ys_.end()), ys_.end());
+
+        // ребро j -> i покрывает полосы [lower_bound(min y), lower_bound(max y)):
+        // сначала считаем размеры полос, потом раскладываем ребра (как в сортировке подсчетом)
+        std::size_t slabs = ys_.empty() ? 0 : ys_.size() - 1;
+        offsets_.assign(slabs + 1, 0);
+        for (std::size_t i = 0, j = polygon.size() - 1; i < polygon.size(); j = i++) {
+            auto [from, to] = SlabRange(polygon[j], polygon[i]);
+            for (std::size_t slab = from; slab < to; slab++) {
+                ++offsets_[slab + 1];
+            }
+        }
+        for (std::size_t slab = 0; slab < slabs; slab++) {
+            offsets_[slab + 1] += offsets_[slab];
+        }
+        edges_.resize(offsets_[slabs]);
+        std::vector<std::size_t> filled(offsets_.begin(), offsets_.end() - 1);
+        for (std::size_t i = 0, j = polygon.size() - 1; i < polygon.size(); j = i++) {
+            auto [from, to] = SlabRange(polygon[j], polygon[i]);
+            for (std::size_t slab = from; slab < to; slab++) {
+                edges_[filled[slab]++] = static_cast<std::uint32_t>(j);
+            }
+        }
+
+        // внутри полосы ребра не пересекаются: порядок по x в середине полосы - порядок на всей высоте
+        for (std::size_t slab = 0; slab < slabs; slab++) {
+            double middle = (ys_[slab] + ys_[slab + 1]) / 2;
+            std::sort(edges_.begin() + offsets_[slab], edges_.begin() + offsets_[slab + 1],
+                      [&](std::uint32_t lhs, std::uint32_t rhs) {
+                          return EdgeX(polygon_[lhs], Next(lhs), middle) < EdgeX(polygon_[rhs], Next(rhs), middle);
+                      });
+        }
+    }
+
+    // ребра, пересекающие луч вправо, - те в полосе, что правее p; их четность - ответ
+    bool Contains(const Point& p) const {
+        if (ys_.empty() || !(p.y >= ys_.front() && p.y < ys_.back())) {
+            return false;
+        }
+        std::size_t slab = std::upper_bound(ys_.begin(), ys_.end(), p.y) - ys_.begin() - 1;
+        std::size_t lo = offsets_[slab];
+        std::size_t hi = offsets_[slab + 1];
+        std::size_t end = hi;
+        while (lo < hi) {
+            std::size_t mid = (lo + hi) / 2;
+            std::uint32_t edge = edges_[mid];
+            if (p.x < EdgeX(polygon_[edge], Next(edge), p.y)) {
+                hi = mid;
+            } else {
+                lo = mid + 1;
+            }
+        }
+        return (end - lo) % 2 == 1;
+    }
+
+    // число ребер во всех полосах - размер индекса
+    std::size_t Entries() const {
+        return edges_.size();
+    }
+
+private:
+    const Point& Next(std::uint32_t edge) const {
+        return polygon_[edge + 1 == polygon_.size() ? 0 : edge + 1];
+    }
+
+    std::pair<std::size_t, std::size_t> SlabRange(const Point& a, const Point& b) const {
+        std::size_t from = std::lower_bound(ys_.begin(), ys_.end(), std::min(a.y, b.y)) - ys_.begin();
+        std::size_t to = std::lower_bound(ys_.begin(), ys_.end(), std::max(a.y, b.y)) - ys_.begin();
+        return {from, to};
+    }
+
+    std::vector<Point> polygon_;
+    std::vector<double> ys_;
+    // ребро j -> j + 1 хранится номером j; ребра полосы s - edges_[offsets_[s], offsets_[s + 1])
+    std::vector<std::size_t> offsets_;
+    std::vector<std::uint32_t> edges_;
+};
+
+// out[i] = 1, если points[i] внутри. Байты, а не std::vector<bool>: потоки пишут
+// в соседние элементы, а биты одного слова vector<bool> так писать нельзя
+void ContainsPoints(const SlabIndex& index, const std::vector<Point>& points, std::vector<std::uint8_t>& out,
+                    unsigned threads) {
+    out.resize(points.size());
+    auto solve = [&](std::size_t from, std::size_t to) {
+        for (std::size_t i = from; i < to; i++) {
+            out[i] = index.Contains(points[i]);
+        }
+    };
+    std::size_t chunk = (points.size() + threads - 1) / threads;
+    if (threads <= 1 || chunk < 4096) {
+        solve(0, points.size());
+        return;
+    }
+    std::vector<std::thread> workers;
+    for (std::size_t from = 0; from < points.size(); from += chunk) {
+        workers.emplace_back(solve, from, std::min(points.size(), from + chunk));
+    }
+    for (std::thread& worker : workers) {
+        worker.join();
+    }
+}
+
+// звездный многоугольник: вершины по углу, радиус в [inner, 1].
+// При inner, близком к 1, он почти выпуклый, при малом inner - "еж" с длинными иглами
+std::vector<Point> Star(std::size_t n, double inner, std::mt19937& gen) {
+    std::uniform_real_distribution<double> radius(inner, 1);
+    std::vector<Point> polygon(n);
+    for (std::size_t i = 0; i < n; i++) {
+        double phi = 2 * 3.14159265358979323846 * i / n;
+        double r = radius(gen);
+        polygon[i] = {r * std::cos(phi), r * std::sin(phi)};
+    }
+    return polygon;
+}
+
+template<typename F>
+auto Measure(const char* name, std::size_t count, F f) {
+    auto start = std::chrono::steady_clock::now();
+    auto result = f();
+    auto finish = std::chrono::steady_clock::now();
+    std::cout << name << ": " << std::chrono::duration<double, std::nano>(finish - start).count() / count
+              << " ns/op" << std::endl;
+    return result;
+}
+
+int main() {
+    const std::size_t queries = 1000000;
+    const unsigned threads = std::max(1u, std::thread::hardware_concurrency());
+    std::mt19937 gen(42);
+    std::uniform_real_distribution<double> unit(-1.1, 1.1);
+    std::vector<Point> points(queries);
+    for (Point& p : points) {
+        p = {unit(gen), unit(gen)};
+    }
+
+    struct Case {
+        const char* name;
+        std::size_t n;
+        double inner;
+    };
+    bool ok = true;
+    for (const Case& test : {Case{"almost convex, 10^5 vertices", 100000, 0.99999},
+                             Case{"hedgehog, 10^3 vertices", 1000, 0.1}}) {
+        std::vector<Point> polygon = Star(test.n, test.inner, gen);
+        std::cout << "--- " << test.name << std::endl;
+        SlabIndex index = Measure("build index", test.n, [&] { return SlabIndex(polygon); });
+        std::cout << "index entries: " << index.Entries() << " (" << double(index.Entries()) / test.n
+                  << " per vertex)" << std::endl;
+
+        std::vector<std::uint8_t> single;
+        std::vector<std::uint8_t> parallel;
+        Measure("SlabIndex, 1 thread", queries, [&] {
+            ContainsPoints(index, points, single, 1);
+            return 0;
+        });
+        Measure("SlabIndex, all threads", queries, [&] {
+            ContainsPoints(index, points, parallel, threads);
+            return 0;
+        });
+        // ray casting на всех запросах слишком долгий: около 10^8 операций
+        std::size_t checked = std::min(queries, 100000000 / test.n);
+        std::vector<std::uint8_t> scan(checked);
+        Measure("RayCastContains, O(n)", checked, [&] {
+            for (std::size_t i = 0; i < checked; i++) {
+                scan[i] = RayCastContains(polygon, points[i]);
+            }
+            return 0;
+        });
+
+        std::size_t disagree = 0;
+        for (std::size_t i = 0; i < checked; i++) {
+            disagree += scan[i] != single[i];
+        }
+        bool same = single == parallel && disagree == 0;
+        ok = ok && same;
+        std::cout << "inside: " << std::count(single.begin(), single.end(), 1) << ", ray casting disagrees on "
+                  << disagree << " of " << checked << ", " << threads << " threads "
+                  << (single == parallel ? "match" : "differ") << std::endl;
+    }
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,290 @@
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <functional>
+#include <iostream>
+#include <random>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+// isCongruentTo / isSimilarTo через каноническую сигнатуру многоугольника:
+// * Signature - для каждой вершины длина ребра i -> i + 1 и угол поворота к следующему ребру,
+//   округленные до сетки с шагом tolerance; для подобия длины делятся на периметр
+// * LeastRotation - алгоритм Бута: начало лексикографически минимального циклического сдвига, O(n)
+// * Canonical - минимум из четырех вариантов: как есть, зеркально, обход в обратную сторону
+//   и то и другое; так сигнатура не зависит от начальной вершины, направления обхода и отражения
+// * GroupBy - разбиение набора фигур на классы конгруэнтности или подобия по хешу сигнатуры
+// Сравнение двух многоугольников - сравнение сигнатур, O(n) вместо перебора всех сдвигов, O(n^2).
+// Значения у самой границы ячейки сетки у двух копий могут округлиться по-разному, тогда
+// класс распадется на два; шаг сетки должен быть много больше погрешности координат.
+// Когда иерархия будет реализована, Polygon сможет хранить сигнатуру у себя.
+
+struct Point {
+    double x;
+    double y;
+};
+
+typedef std::pair<long long, long long> Element;
+typedef std::vector<Element> Signature;
+
+// вершины подряд, без сигнатуры: длины ребер и углы поворота в радианах
+struct Outline {
+    std::vector<double> lengths;
+    std::vector<double> turns;
+};
+
+Outline Measurements(const std::vector<Point>& polygon) {
+    std::size_t n = polygon.size();
+    Outline shape;
+    for (std::size_t i = 0; i < n; i++) {
+        const Point& a = polygon[i];
+        const Point& b = polygon[(i + 1) % n];
+        const Point& c = polygon[(i + 2) % n];
+        double ux = b.x - a.x;
+        double uy = b.y - a.y;
+        double vx = c.x - b.x;
+        double vy = c.y - b.y;
+        shape.lengths.push_back(std::hypot(ux, uy));
+        shape.turns.push_back(std::atan2(ux * vy - uy * vx, ux * vx + uy * vy));
+    }
+    return shape;
+}
+
+// Алгоритм Бута: префикс-функция по удвоенной последовательности,
+// k - текущий кандидат на начало минимального сдвига
+std::size_t LeastRotation(const Signature& s) {
+    std::size_t n = s.size();
+    std::vector<long long> failure(2 * n, -1);
+    std::size_t k = 0;
+    for (std::size_t j = 1; j < 2 * n; j++) {
+        const Element& current = s[j % n];
+        long long i = failure[j - k - 1];
+        while (i != -1 && current != s[(k + i + 1) % n]) {
+            if (current < s[(k + i + 1) % n]) {
+                k = j - i - 1;
+            }
+            i = failure[i];
+        }
+        if (current != s[(k + i + 1) % n]) {
+            // здесь i == -1
+            if (current < s[k % n]) {
+                k = j;
+            }
+            failure[j - k] = -1;
+        } else {
+            failure[j - k] = i + 1;
+        }
+    }
+    return k % n;
+}
+
+Signature Rotated(const Signature& s, std::size_t start) {
+    Signature rotated(s.begin() + start, s.end());
+    rotated.insert(rotated.end(), s.begin(), s.begin() + start);
+    return rotated;
+}
+
+// Обход в обратную сторону: ребро j - бывшее ребро n - 2 - j, поворот j - бывший
+// поворот n - 3 - j с обратным знаком. Отражение меняет знак всех поворотов
+Signature Canonical(const std::vector<double>& lengths, const std::vector<double>& turns, double tolerance) {
+    std::size_t n = lengths.size();
+    Signature best;
+    for (int variant = 0; variant < 4; variant++) {
+        bool reversed = variant & 1;
+        bool mirrored = variant & 2;
+        Signature s(n);
+        for (std::size_t j = 0; j < n; j++) {
+            double length = reversed ? lengths[(2 * n - 2 - j) % n] : lengths[j];
+            double turn = reversed ? -turns[(2 * n - 3 - j) % n] : turns[j];
+            s[j] = {std::llround(length / tolerance), std::llround((mirrored ? -turn : turn) / tolerance)};
+        }
+        s = Rotated(s, LeastRotation(s));
+        if (variant == 0 || s < best) {
+            best = std::move(s);
+        }
+    }
+    return best;
+}
+
+Signature CongruenceSignature(const std::vector<Point>& polygon, double tolerance) {
+    Outline shape = Measurements(polygon);
+    return Canonical(shape.lengths, shape.turns, tolerance);
+}
+
+Signature SimilaritySignature(const std::vector<Point>& polygon, double tolerance) {
+    Outline shape = Measurements(polygon);
+    double perimeter = 0;
+    for (double length : shape.lengths) {
+        perimeter += length;
+    }
+    for (double& length : shape.lengths) {
+        length /= perimeter;
+    }
+    return Canonical(shape.lengths, shape.turns, tolerance);
+}
+
+struct SignatureHash {
+    std::size_t operator()(const Signature& s) const {
+        std::size_t hash = s.size();
+        for (const Element& e : s) {
+            hash = hash * 1000003 ^ std::hash<long long>()(e.first);
+            hash = hash * 1000003 ^ std::hash<long long>()(e.second);
+        }
+        return hash;
+    }
+};
+
+// номер класса для каждой фигуры, классы нумеруются в порядке первого появления
+std::vector<std::size_t> GroupBy(const std::vector<std::vector<Point>>& shapes, bool similarity, double tolerance) {
+    std::unordered_map<Signature, std::size_t, SignatureHash> classes;
+    std::vector<std::size_t> result;
+    result.reserve(shapes.size());
+    for (const std::vector<Point>& shape : shapes) {
+        Signature s = similarity ? SimilaritySignature(shape, tolerance) : CongruenceSignature(shape, tolerance);
+        result.push_back(classes.emplace(std::move(s), classes.size()).first->second);
+    }
+    return result;
+}
+
+// перебор всех начальных вершин и направлений с допуском, O(n^2) в худшем случае
+bool NaiveCongruent(const std::vector<Point>& lhs, const std::vector<Point>& rhs, double tolerance) {
+    if (lhs.size() != rhs.size()) {
+        return false;
+    }
+    std::size_t n = lhs.size();
+    Outline a = Measurements(lhs);
+    Outline b = Measurements(rhs);
+    for (int variant = 0; variant < 4; variant++) {
+        bool reversed = variant & 1;
+        bool mirrored = variant & 2;
+        for (std::size_t shift = 0; shift < n; shift++) {
+            bool same = true;
+            for (std::size_t j = 0; j < n && same; j++) {
+                std::size_t k = (j + shift) % n;
+                double length = reversed ? b.lengths[(2 * n - 2 - k) % n] : b.lengths[k];
+                double turn = reversed ? -b.turns[(2 * n - 3 - k) % n] : b.turns[k];
+                turn = mirrored ? -turn : turn;
+                same = std::fabs(a.lengths[j] - length) <= tolerance && std::fabs(a.turns[j] - turn) <= tolerance;
+            }
+            if (same) {
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+// копия: поворот, сдвиг, масштаб, возможно отражение, другая начальная вершина и направление обхода
+std::vector<Point> Moved(const std::vector<Point>& polygon, double scale, std::mt19937& gen) {
+    std::uniform_real_distribution<double> angle(0, 2 * 3.14159265358979323846);
+    std::uniform_real_distribution<double> offset(-100, 100);
+    double phi = angle(gen);
+    double dx = offset(gen);
+    double dy = offset(gen);
+    bool mirrored = gen() % 2;
+    std::vector<Point> moved;
+    for (const Point& p : polygon) {
+        double x = scale * p.x;
+        double y = scale * (mirrored ? -p.y : p.y);
+        moved.push_back({x * std::cos(phi) - y * std::sin(phi) + dx, x * std::sin(phi) + y * std::cos(phi) + dy});
+    }
+    std::rotate(moved.begin(), moved.begin() + gen() % moved.size(), moved.end());
+    if (gen() % 2) {
+        std::reverse(moved.begin(), moved.end());
+    }
+    return moved;
+}
+
+std::vector<Point> Star(std::size_t n, std::mt19937& gen) {
+    std::uniform_real_distribution<double> radius(0.3, 1);
+    std::vector<Point> polygon(n);
+    for (std::size_t i = 0; i < n; i++) {
+        double phi = 2 * 3.14159265358979323846 * i / n;
+        double r = radius(gen);
+        polygon[i] = {r * std::cos(phi), r * std::sin(phi)};
+    }
+    return polygon;
+}
+
+template<typename F>
+auto Measure(const char* name, std::size_t count, F f) {
+    auto start = std::chrono::steady_clock::now();
+    auto result = f();
+    auto finish = std::chrono::steady_clock::now();
+    std::cout << name << ": " << std::chrono::duration<double, std::nano>(finish - start).count() / count
+              << " ns/op" << std::endl;
+    return result;
+}
+
+int main() {
+    const double tolerance = 1e-6;
+    std::mt19937 gen(42);
+
+    // каталог: bases разных форм, каждая в двух масштабах, в каждом copies копий.
+    // Классов конгруэнтности должно быть 2 * bases, подобия - bases
+    const std::size_t bases = 1000;
+    const std::size_t copies = 5;
+    std::vector<std::vector<Point>> shapes;
+    std::vector<std::size_t> base_of;
+    std::vector<std::size_t> scale_of;
+    for (std::size_t base = 0; base < bases; base++) {
+        std::vector<Point> polygon = Star(3 + gen() % 38, gen);
+        double scale = std::uniform_real_distribution<double>(0.1, 10)(gen);
+        for (std::size_t copy = 0; copy < 2 * copies; copy++) {
+            shapes.push_back(Moved(polygon, copy < copies ? 1 : scale, gen));
+            base_of.push_back(base);
+            scale_of.push_back(copy < copies ? 0 : 1);
+        }
+    }
+    std::vector<std::size_t> congruent = Measure("GroupBy congruence, per shape", shapes.size(), [&] {
+        return GroupBy(shapes, false, tolerance);
+    });
+    std::vector<std::size_t> similar = Measure("GroupBy similarity, per shape", shapes.size(), [&] {
+        return GroupBy(shapes, true, tolerance);
+    });
+
+    // классы совпадают с разбиением по построению, если номер класса однозначно
+    // определяет (форма, масштаб) и наоборот
+    std::size_t congruence_classes = *std::max_element(congruent.begin(), congruent.end()) + 1;
+    std::size_t similarity_classes = *std::max_element(similar.begin(), similar.end()) + 1;
+    bool ok = congruence_classes == 2 * bases && similarity_classes == bases;
+    for (std::size_t i = 0; i < shapes.size(); i++) {
+        std::size_t first = i - i % copies;
+        ok = ok && congruent[i] == congruent[first] && similar[i] == similar[i - i % (2 * copies)];
+    }
+    std::cout << "congruence classes: " << congruence_classes << ", similarity classes: " << similarity_classes
+              << " (expected " << 2 * bases << ", " << bases << ")" << std::endl;
+
+    // сравнение сигнатур против перебора на случайных парах, половина из них - из одного класса
+    std::size_t disagree = 0;
+    for (int pair = 0; pair < 2000; pair++) {
+        std::size_t i = gen() % shapes.size();
+        std::size_t j = pair % 2 ? gen() % shapes.size() : i - i % copies + gen() % copies;
+        bool by_signature = congruent[i] == congruent[j];
+        disagree += by_signature != NaiveCongruent(shapes[i], shapes[j], 10 * tolerance);
+    }
+    std::cout << "naive comparison disagrees on " << disagree << " of 2000 pairs" << std::endl;
+    ok = ok && disagree == 0;
+
+    // худший случай перебора: правильный многоугольник с одной сдвинутой вершиной,
+    // почти каждый сдвиг совпадает до самого отличия
+    const std::size_t n = 20000;
+    std::vector<Point> regular(n);
+    for (std::size_t i = 0; i < n; i++) {
+        double phi = 2 * 3.14159265358979323846 * i / n;
+        double r = i == n / 2 ? 1.001 : 1;
+        regular[i] = {r * std::cos(phi), r * std::sin(phi)};
+    }
+    std::vector<Point> moved = Moved(regular, 1, gen);
+    bool naive = Measure("NaiveCongruent, 2 * 10^4 vertices", 1, [&] {
+        return NaiveCongruent(regular, moved, 1e-9);
+    });
+    bool fast = Measure("signatures, 2 * 10^4 vertices", 1, [&] {
+        return CongruenceSignature(regular, 1e-9) == CongruenceSignature(moved, 1e-9);
+    });
+    std::cout << "congruent: " << naive << " " << fast << std::endl;
+    ok = ok && naive && fast;
+    return ok ? 0 : 1;
+}
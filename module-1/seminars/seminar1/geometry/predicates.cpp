@@ -0,0 +1,348 @@
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <iostream>
+#include <limits>
+#include <random>
+#include <vector>
+
+// Адаптивные геометрические предикаты в духе Shewchuk
+// ("Adaptive Precision Floating-Point Arithmetic and Fast Robust Geometric Predicates"):
+// * Orient2d(a, b, c) > 0, если a -> b -> c поворачивает против часовой стрелки
+// * InCircle(a, b, c, d) > 0, если d внутри окружности через a, b, c (a, b, c против часовой)
+// Сначала считается обычный определитель в double и оценка его ошибки округления;
+// если модуль больше оценки - знак верный. Иначе (почти вырожденный случай) определитель
+// пересчитывается точно в арифметике разложений: число - сумма неперекрывающихся double.
+// Точка - простая структура: через эти предикаты пойдут isConvex, containsPoint и сравнения
+// Point / Line из homework/Geometry, когда иерархия будет реализована.
+
+struct Point {
+    double x;
+    double y;
+};
+
+namespace exact {
+    // x + y == a + b точно, x = fl(a + b)
+    void TwoSum(double a, double b, double& x, double& y) {
+        x = a + b;
+        double b_virtual = x - a;
+        double a_virtual = x - b_virtual;
+        y = (a - a_virtual) + (b - b_virtual);
+    }
+
+    // x + y == a * b точно: fma округляет только один раз
+    void TwoProduct(double a, double b, double& x, double& y) {
+        x = a * b;
+        y = std::fma(a, b, -x);
+    }
+
+    // Разложение: компоненты по возрастанию модуля, нули отброшены,
+    // знак числа - знак последней (старшей) компоненты
+    typedef std::vector<double> Expansion;
+
+    Expansion FromDifference(double a, double b) {
+        double x;
+        double y;
+        TwoSum(a, -b, x, y);
+        Expansion result;
+        if (y != 0) {
+            result.push_back(y);
+        }
+        if (x != 0) {
+            result.push_back(x);
+        }
+        return result;
+    }
+
+    // e + b, Grow-Expansion
+    Expansion Add(const Expansion& e, double b) {
+        Expansion result;
+        double q = b;
+        for (double component : e) {
+            double sum;
+            double error;
+            TwoSum(q, component, sum, error);
+            if (error != 0) {
+                result.push_back(error);
+            }
+            q = sum;
+        }
+        if (q != 0 || result.empty()) {
+            result.push_back(q);
+        }
+        return result;
+    }
+
+    // e + f: по одной компоненте f. Квадратично, но точный путь нужен редко
+    Expansion Add(const Expansion& e, const Expansion& f) {
+        Expansion result = e;
+        for (double component : f) {
+            result = Add(result, component);
+        }
+        return result;
+    }
+
+    Expansion Negate(Expansion e) {
+        for (double& component : e) {
+            component = -component;
+        }
+        return e;
+    }
+
+    // e * b, Scale-Expansion
+    Expansion Scale(const Expansion& e, double b) {
+        Expansion result;
+        if (e.empty()) {
+            return result;
+        }
+        double q;
+        double error;
+        TwoProduct(e[0], b, q, error);
+        if (error != 0) {
+            result.push_back(error);
+        }
+        for (std::size_t i = 1; i < e.size(); i++) {
+            double product;
+            double product_error;
+            TwoProduct(e[i], b, product, product_error);
+            double sum;
+            TwoSum(q, product_error, sum, error);
+            if (error != 0) {
+                result.push_back(error);
+            }
+            TwoSum(product, sum, q, error);
+            if (error != 0) {
+                result.push_back(error);
+            }
+        }
+        if (q != 0) {
+            result.push_back(q);
+        }
+        return result;
+    }
+
+    Expansion Multiply(const Expansion& e, const Expansion& f) {
+        Expansion result;
+        for (double component : f) {
+            result = Add(result, Scale(e, component));
+        }
+        return result;
+    }
+
+    double Sign(const Expansion& e) {
+        for (std::size_t i = e.size(); i-- > 0;) {
+            if (e[i] != 0) {
+                return e[i] > 0 ? 1 : -1;
+            }
+        }
+        return 0;
+    }
+
+    double Orient2d(const Point& a, const Point& b, const Point& c) {
+        Expansion acx = FromDifference(a.x, c.x);
+        Expansion acy = FromDifference(a.y, c.y);
+        Expansion bcx = FromDifference(b.x, c.x);
+        Expansion bcy = FromDifference(b.y, c.y);
+        return Sign(Add(Multiply(acx, bcy), Negate(Multiply(acy, bcx))));
+    }
+
+    double InCircle(const Point& a, const Point& b, const Point& c, const Point& d) {
+        Expansion adx = FromDifference(a.x, d.x);
+        Expansion ady = FromDifference(a.y, d.y);
+        Expansion bdx = FromDifference(b.x, d.x);
+        Expansion bdy = FromDifference(b.y, d.y);
+        Expansion cdx = FromDifference(c.x, d.x);
+        Expansion cdy = FromDifference(c.y, d.y);
+
+        Expansion alift = Add(Multiply(adx, adx), Multiply(ady, ady));
+        Expansion blift = Add(Multiply(bdx, bdx), Multiply(bdy, bdy));
+        Expansion clift = Add(Multiply(cdx, cdx), Multiply(cdy, cdy));
+        Expansion bc = Add(Multiply(bdx, cdy), Negate(Multiply(cdx, bdy)));
+        Expansion ca = Add(Multiply(cdx, ady), Negate(Multiply(adx, cdy)));
+        Expansion ab = Add(Multiply(adx, bdy), Negate(Multiply(bdx, ady)));
+        return Sign(Add(Add(Multiply(alift, bc), Multiply(blift, ca)), Multiply(clift, ab)));
+    }
+}
+
+// оценки ошибки из статьи Shewchuk, epsilon = 2^-53
+const double kEpsilon = std::numeric_limits<double>::epsilon() / 2;
+const double kOrientBound = (3 + 16 * kEpsilon) * kEpsilon;
+const double kInCircleBound = (10 + 96 * kEpsilon) * kEpsilon;
+
+// сколько раз фильтр не справился и понадобилась точная арифметика
+static std::size_t exact_calls = 0;
+
+// знак результата верный, величина - как у обычного определителя
+double Orient2d(const Point& a, const Point& b, const Point& c) {
+    double left = (a.x - c.x) * (b.y - c.y);
+    double right = (a.y - c.y) * (b.x - c.x);
+    double det = left - right;
+    // без ветвлений по знакам слагаемых: при разных знаках |det| = |left| + |right|
+    // и проверка проходит сама
+    if (std::fabs(det) >= kOrientBound * (std::fabs(left) + std::fabs(right))) {
+        return det;
+    }
+    ++exact_calls;
+    return exact::Orient2d(a, b, c);
+}
+
+double InCircle(const Point& a, const Point& b, const Point& c, const Point& d) {
+    double adx = a.x - d.x;
+    double ady = a.y - d.y;
+    double bdx = b.x - d.x;
+    double bdy = b.y - d.y;
+    double cdx = c.x - d.x;
+    double cdy = c.y - d.y;
+
+    double bdxcdy = bdx * cdy;
+    double cdxbdy = cdx * bdy;
+    double alift = adx * adx + ady * ady;
+    double cdxady = cdx * ady;
+    double adxcdy = adx * cdy;
+    double blift = bdx * bdx + bdy * bdy;
+    double adxbdy = adx * bdy;
+    double bdxady = bdx * ady;
+    double clift = cdx * cdx + cdy * cdy;
+
+    double det = alift * (bdxcdy - cdxbdy) + blift * (cdxady - adxcdy) + clift * (adxbdy - bdxady);
+    double permanent = (std::fabs(bdxcdy) + std::fabs(cdxbdy)) * alift
+                       + (std::fabs(cdxady) + std::fabs(adxcdy)) * blift
+                       + (std::fabs(adxbdy) + std::fabs(bdxady)) * clift;
+    if (std::fabs(det) > kInCircleBound * permanent) {
+        return det;
+    }
+    ++exact_calls;
+    return exact::InCircle(a, b, c, d);
+}
+
+// без фильтра: то, что обычно пишут в Polygon::isConvex и containsPoint
+double NaiveOrient2d(const Point& a, const Point& b, const Point& c) {
+    return (a.x - c.x) * (b.y - c.y) - (a.y - c.y) * (b.x - c.x);
+}
+
+double NaiveInCircle(const Point& a, const Point& b, const Point& c, const Point& d) {
+    double adx = a.x - d.x;
+    double ady = a.y - d.y;
+    double bdx = b.x - d.x;
+    double bdy = b.y - d.y;
+    double cdx = c.x - d.x;
+    double cdy = c.y - d.y;
+    return (adx * adx + ady * ady) * (bdx * cdy - cdx * bdy) + (bdx * bdx + bdy * bdy) * (cdx * ady - adx * cdy)
+           + (cdx * cdx + cdy * cdy) * (adx * bdy - bdx * ady);
+}
+
+int Sign(double value) {
+    return (value > 0) - (value < 0);
+}
+
+template<typename F>
+double Measure(const char* name, std::size_t count, F f) {
+    std::size_t exact_before = exact_calls;
+    auto start = std::chrono::steady_clock::now();
+    double result = f();
+    auto finish = std::chrono::steady_clock::now();
+    std::cout << name << ": " << std::chrono::duration<double, std::nano>(finish - start).count() / count
+              << " ns/op, exact " << exact_calls - exact_before << std::endl;
+    return result;
+}
+
+int main() {
+    // Kettner et al., "Classroom examples of robustness problems": точка p, сдвинутая
+    // на i, j ulp, против прямой q -> r. Наивный знак "рябит" вокруг прямой
+    Point q = {12, 12};
+    Point r = {24, 24};
+    int wrong = 0;
+    for (int i = 0; i < 256; i++) {
+        for (int j = 0; j < 256; j++) {
+            Point p = {0.5 + i * std::ldexp(1.0, -53), 0.5 + j * std::ldexp(1.0, -53)};
+            int naive = Sign(NaiveOrient2d(p, q, r));
+            int robust = Sign(Orient2d(p, q, r));
+            if (robust != Sign(exact::Orient2d(p, q, r))) {
+                std::cout << "filter error at " << i << " " << j << std::endl;
+                return 1;
+            }
+            wrong += naive != robust;
+        }
+    }
+    std::cout << "orient2d near a line: naive sign wrong in " << wrong << " of 65536 points" << std::endl;
+
+    // точки окружности радиуса 5 с целыми координатами, сдвинутые на 0.1:
+    // сдвиг не представим точно, поэтому четверки "почти" на окружности
+    Point circle[] = {{5, 0}, {4, 3}, {3, 4}, {0, 5}, {-3, 4}, {-4, 3}, {-5, 0}, {-4, -3}, {0, -5}, {3, -4}};
+    wrong = 0;
+    int quadruples = 0;
+    for (double shift = 0.1; shift < 100; shift *= 1.7) {
+        for (const Point& a : circle) {
+            for (const Point& d : circle) {
+                Point pa = {a.x + shift, a.y + shift};
+                Point pb = {circle[3].x + shift, circle[3].y + shift};
+                Point pc = {circle[6].x + shift, circle[6].y + shift};
+                Point pd = {d.x + shift, d.y + shift};
+                int robust = Sign(InCircle(pa, pb, pc, pd));
+                if (robust != Sign(exact::InCircle(pa, pb, pc, pd))) {
+                    std::cout << "filter error in InCircle" << std::endl;
+                    return 1;
+                }
+                wrong += Sign(NaiveInCircle(pa, pb, pc, pd)) != robust;
+                ++quadruples;
+            }
+        }
+    }
+    std::cout << "incircle near a circle: naive sign wrong in " << wrong << " of " << quadruples << std::endl;
+
+    // случайные точки: фильтр почти всегда справляется сам
+    const std::size_t count = 10000000;
+    std::mt19937 gen(42);
+    std::uniform_real_distribution<double> coord(-1, 1);
+    std::vector<Point> points(count + 3);
+    for (Point& p : points) {
+        p = {coord(gen), coord(gen)};
+    }
+    double naive = Measure("naive orient2d, random", count, [&] {
+        double sum = 0;
+        for (std::size_t i = 0; i < count; i++) {
+            sum += Sign(NaiveOrient2d(points[i], points[i + 1], points[i + 2]));
+        }
+        return sum;
+    });
+    double adaptive = Measure("adaptive orient2d, random", count, [&] {
+        double sum = 0;
+        for (std::size_t i = 0; i < count; i++) {
+            sum += Sign(Orient2d(points[i], points[i + 1], points[i + 2]));
+        }
+        return sum;
+    });
+    double naive_circle = Measure("naive incircle, random", count, [&] {
+        double sum = 0;
+        for (std::size_t i = 0; i < count; i++) {
+            sum += Sign(NaiveInCircle(points[i], points[i + 1], points[i + 2], points[i + 3]));
+        }
+        return sum;
+    });
+    double adaptive_circle = Measure("adaptive incircle, random", count, [&] {
+        double sum = 0;
+        for (std::size_t i = 0; i < count; i++) {
+            sum += Sign(InCircle(points[i], points[i + 1], points[i + 2], points[i + 3]));
+        }
+        return sum;
+    });
+
+    // точки на одной прямой y = x / 3: почти каждый вызов уходит в точную арифметику
+    const std::size_t degenerate = 100000;
+    std::vector<Point> line(degenerate + 2);
+    for (Point& p : line) {
+        double x = coord(gen);
+        p = {x, x / 3};
+    }
+    double collinear = Measure("adaptive orient2d, collinear", degenerate, [&] {
+        double sum = 0;
+        for (std::size_t i = 0; i < degenerate; i++) {
+            sum += Sign(Orient2d(line[i], line[i + 1], line[i + 2]));
+        }
+        return sum;
+    });
+
+    std::cout << "checksum: " << naive << " " << adaptive << " " << naive_circle << " " << adaptive_circle << " "
+              << collinear << std::endl;
+    return 0;
+}
@@ -0,0 +1,622 @@
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+#include <random>
+#include <set>
+#include <utility>
+#include <vector>
+
+// Триангуляция простого многоугольника за O(n log n) и локализация точки по ней:
+// * MonotoneDiagonals - заметание сверху вниз (de Berg и др., "Computational Geometry", гл. 3):
+//   диагонали из вершин-"расщеплений" и в вершины-"слияния" режут многоугольник на y-монотонные части
+// * Faces - обход частей по полуребрам, отсортированным вокруг вершин по углу
+// * TriangulateMonotone - стек по вершинам монотонной части в порядке убывания y, O(k)
+// * Triangulate - все вместе: n - 2 тройки индексов вершин, каждая против часовой стрелки
+// * TriangleLocator - полосы по y вершин и дерево отрезков над ними: ребро триангуляции лежит
+//   в O(log n) узлах, ребра узла упорядочены по x; у каждого ребра запомнен треугольник справа.
+//   Памяти O(n log n), запрос O(log^2 n)
+// Вершины сравниваются по y, при равных y выше считается левая: так горизонтальные ребра
+// обрабатываются как слегка наклоненные.
+// Когда иерархия будет реализована, Polygon сможет хранить триангуляцию и локатор у себя.
+
+struct Point {
+    double x;
+    double y;
+};
+
+// > 0, если поворот o -> a -> b против часовой стрелки
+double Cross(const Point& o, const Point& a, const Point& b) {
+    return (a.x - o.x) * (b.y - o.y) - (a.y - o.y) * (b.x - o.x);
+}
+
+bool Above(const Point& p, const Point& q) {
+    return p.y > q.y || (p.y == q.y && p.x < q.x);
+}
+
+double EdgeX(const Point& a, const Point& b, double y) {
+    return a.x + (y - a.y) * (b.x - a.x) / (b.y - a.y);
+}
+
+double SignedArea(const std::vector<Point>& polygon) {
+    double area = 0;
+    for (std::size_t i = 0, j = polygon.size() - 1; i < polygon.size(); j = i++) {
+        area += polygon[j].x * polygon[i].y - polygon[i].x * polygon[j].y;
+    }
+    return area / 2;
+}
+
+struct Triangle {
+    std::size_t a;
+    std::size_t b;
+    std::size_t c;
+};
+
+namespace detail {
+    enum VertexType { kStart, kEnd, kSplit, kMerge, kRegular };
+
+    // Ребро i -> i + 1 в статусе заметания упорядочено по x на текущей высоте.
+    // Ребра статуса не пересекаются, поэтому порядок не меняется, пока они в нем лежат
+    struct SweepLess {
+        using is_transparent = void;
+
+        const std::vector<Point>* polygon;
+        const double* y;
+
+        double X(std::size_t edge) const {
+            const Point& a = (*polygon)[edge];
+            const Point& b = (*polygon)[edge + 1 == polygon->size() ? 0 : edge + 1];
+            // горизонтальное ребро лежит в статусе только на своей высоте, где другие ребра
+            // проходят левее или правее всего отрезка
+            return a.y == b.y ? std::min(a.x, b.x) : EdgeX(a, b, *y);
+        }
+
+        bool operator()(std::size_t lhs, std::size_t rhs) const {
+            return X(lhs) < X(rhs);
+        }
+
+        bool operator()(std::size_t lhs, double x) const {
+            return X(lhs) < x;
+        }
+
+        bool operator()(double x, std::size_t rhs) const {
+            return x < X(rhs);
+        }
+    };
+
+    // polygon - против часовой стрелки; внутренность слева от каждого ребра i -> i + 1
+    std::vector<std::pair<std::size_t, std::size_t>> MonotoneDiagonals(const std::vector<Point>& polygon) {
+        std::size_t n = polygon.size();
+        std::vector<VertexType> type(n);
+        for (std::size_t i = 0; i < n; i++) {
+            const Point& prev = polygon[(i + n - 1) % n];
+            const Point& next = polygon[(i + 1) % n];
+            bool convex = Cross(prev, polygon[i], next) > 0;
+            if (Above(polygon[i], prev) && Above(polygon[i], next)) {
+                type[i] = convex ? kStart : kSplit;
+            } else if (Above(prev, polygon[i]) && Above(next, polygon[i])) {
+                type[i] = convex ? kEnd : kMerge;
+            } else {
+                type[i] = kRegular;
+            }
+        }
+        std::vector<std::size_t> order(n);
+        for (std::size_t i = 0; i < n; i++) {
+            order[i] = i;
+        }
+        std::sort(order.begin(), order.end(), [&](std::size_t lhs, std::size_t rhs) {
+            return Above(polygon[lhs], polygon[rhs]);
+        });
+
+        double sweep_y = 0;
+        typedef std::set<std::size_t, SweepLess> Status;
+        Status status(SweepLess{&polygon, &sweep_y});
+        std::vector<Status::iterator> where(n);
+        std::vector<std::size_t> helper(n);
+        std::vector<std::pair<std::size_t, std::size_t>> diagonals;
+
+        auto insert = [&](std::size_t edge, std::size_t vertex) {
+            where[edge] = status.insert(edge).first;
+            helper[edge] = vertex;
+        };
+        // у ребра, которое заканчивается в вершине, помощник-"слияние" соединяется с ней
+        auto finish = [&](std::size_t edge, std::size_t vertex) {
+            if (type[helper[edge]] == kMerge) {
+                diagonals.push_back({vertex, helper[edge]});
+            }
+            status.erase(where[edge]);
+        };
+        // ближайшее ребро статуса слева от вершины
+        auto left_of = [&](std::size_t vertex) {
+            return *std::prev(status.lower_bound(polygon[vertex].x));
+        };
+
+        for (std::size_t v : order) {
+            sweep_y = polygon[v].y;
+            std::size_t prev_edge = (v + n - 1) % n;
+            switch (type[v]) {
+                case kStart:
+                    insert(v, v);
+                    break;
+                case kEnd:
+                    finish(prev_edge, v);
+                    break;
+                case kSplit: {
+                    std::size_t left = left_of(v);
+                    diagonals.push_back({v, helper[left]});
+                    helper[left] = v;
+                    insert(v, v);
+                    break;
+                }
+                case kMerge: {
+                    finish(prev_edge, v);
+                    std::size_t left = left_of(v);
+                    if (type[helper[left]] == kMerge) {
+                        diagonals.push_back({v, helper[left]});
+                    }
+                    helper[left] = v;
+                    break;
+                }
+                case kRegular:
+                    // граница идет вниз - внутренность справа от вершины
+                    if (Above(polygon[(v + n - 1) % n], polygon[v])) {
+                        finish(prev_edge, v);
+                        insert(v, v);
+                    } else {
+                        std::size_t left = left_of(v);
+                        if (type[helper[left]] == kMerge) {
+                            diagonals.push_back({v, helper[left]});
+                        }
+                        helper[left] = v;
+                    }
+                    break;
+            }
+        }
+        return diagonals;
+    }
+
+    // Грани, на которые диагонали режут многоугольник, - циклы вершин против часовой стрелки.
+    // Полуребра вокруг каждой вершины упорядочены по углу; следующее полуребро грани -
+    // предыдущее по углу перед обратным к текущему
+    std::vector<std::vector<std::size_t>> Faces(const std::vector<Point>& polygon,
+                                                const std::vector<std::pair<std::size_t, std::size_t>>& diagonals) {
+        std::size_t n = polygon.size();
+        std::vector<std::size_t> from;
+        std::vector<std::size_t> to;
+        auto add_pair = [&](std::size_t a, std::size_t b) {
+            from.push_back(a);
+            to.push_back(b);
+            from.push_back(b);
+            to.push_back(a);
+        };
+        // полуребро 2k и 2k + 1 - пара; у ребер многоугольника внешнее - нечетное
+        for (std::size_t i = 0; i < n; i++) {
+            add_pair(i, (i + 1) % n);
+        }
+        for (const auto& diagonal : diagonals) {
+            add_pair(diagonal.first, diagonal.second);
+        }
+
+        std::size_t half_edges = from.size();
+        std::vector<double> angle(half_edges);
+        std::vector<std::size_t> sorted(half_edges);
+        for (std::size_t h = 0; h < half_edges; h++) {
+            angle[h] = std::atan2(polygon[to[h]].y - polygon[from[h]].y, polygon[to[h]].x - polygon[from[h]].x);
+            sorted[h] = h;
+        }
+        std::sort(sorted.begin(), sorted.end(), [&](std::size_t lhs, std::size_t rhs) {
+            return from[lhs] != from[rhs] ? from[lhs] < from[rhs] : angle[lhs] < angle[rhs];
+        });
+        std::vector<std::size_t> previous(half_edges);
+        for (std::size_t begin = 0, end = 0; begin < half_edges; begin = end) {
+            while (end < half_edges && from[sorted[end]] == from[sorted[begin]]) {
+                ++end;
+            }
+            for (std::size_t k = begin; k < end; k++) {
+                previous[sorted[k]] = sorted[k == begin ? end - 1 : k - 1];
+            }
+        }
+
+        std::vector<std::vector<std::size_t>> faces;
+        std::vector<bool> visited(half_edges, false);
+        for (std::size_t start = 0; start < half_edges; start++) {
+            if (visited[start] || (start < 2 * n && start % 2 == 1)) {
+                continue;
+            }
+            faces.emplace_back();
+            for (std::size_t h = start; !visited[h]; h = previous[h ^ 1]) {
+                visited[h] = true;
+                faces.back().push_back(from[h]);
+            }
+        }
+        return faces;
+    }
+
+    void AddTriangle(const std::vector<Point>& polygon, std::size_t a, std::size_t b, std::size_t c,
+                     std::vector<Triangle>& out) {
+        if (Cross(polygon[a], polygon[b], polygon[c]) < 0) {
+            std::swap(b, c);
+        }
+        out.push_back({a, b, c});
+    }
+
+    // face - y-монотонный многоугольник против часовой стрелки. Левая цепь - от верхней
+    // вершины вперед до нижней, правая - остальные; вершины берутся слиянием цепей по убыванию
+    void TriangulateMonotone(const std::vector<Point>& polygon, const std::vector<std::size_t>& face,
+                             std::vector<Triangle>& out) {
+        std::size_t k = face.size();
+        auto above = [&](std::size_t lhs, std::size_t rhs) {
+            return Above(polygon[face[lhs]], polygon[face[rhs]]);
+        };
+        std::size_t top = 0;
+        std::size_t bottom = 0;
+        for (std::size_t i = 1; i < k; i++) {
+            top = above(i, top) ? i : top;
+            bottom = above(bottom, i) ? i : bottom;
+        }
+
+        std::vector<std::pair<std::size_t, bool>> sorted;
+        std::size_t left = top;
+        std::size_t right = (top + k - 1) % k;
+        sorted.push_back({face[top], true});
+        left = (left + 1) % k;
+        while (sorted.size() < k) {
+            bool take_left = right == bottom || (left != (bottom + 1) % k && above(left, right));
+            if (take_left) {
+                sorted.push_back({face[left], true});
+                left = (left + 1) % k;
+            } else {
+                sorted.push_back({face[right], false});
+                right = (right + k - 1) % k;
+            }
+        }
+
+        std::vector<std::pair<std::size_t, bool>> stack = {sorted[0], sorted[1]};
+        for (std::size_t j = 2; j + 1 < k; j++) {
+            auto [vertex, on_left] = sorted[j];
+            if (on_left != stack.back().second) {
+                for (std::size_t i = 0; i + 1 < stack.size(); i++) {
+                    AddTriangle(polygon, vertex, stack[i].first, stack[i + 1].first, out);
+                }
+                std::pair<std::size_t, bool> last = stack.back();
+                stack = {last, sorted[j]};
+            } else {
+                std::pair<std::size_t, bool> last = stack.back();
+                stack.pop_back();
+                // диагональ внутри, если угол в last выпуклый со стороны цепи
+                while (!stack.empty()) {
+                    double turn = Cross(polygon[stack.back().first], polygon[last.first], polygon[vertex]);
+                    if (on_left ? turn <= 0 : turn >= 0) {
+                        break;
+                    }
+                    AddTriangle(polygon, vertex, last.first, stack.back().first, out);
+                    last = stack.back();
+                    stack.pop_back();
+                }
+                stack.push_back(last);
+                stack.push_back(sorted[j]);
+            }
+        }
+        for (std::size_t i = 0; i + 1 < stack.size(); i++) {
+            AddTriangle(polygon, sorted[k - 1].first, stack[i].first, stack[i + 1].first, out);
+        }
+    }
+}  // namespace detail
+
+// простой многоугольник, обход в любую сторону; индексы - в исходный массив вершин
+std::vector<Triangle> Triangulate(const std::vector<Point>& polygon) {
+    std::size_t n = polygon.size();
+    bool clockwise = SignedArea(polygon) < 0;
+    std::vector<Point> ccw(polygon);
+    if (clockwise) {
+        std::reverse(ccw.begin(), ccw.end());
+    }
+    std::vector<Triangle> triangles;
+    triangles.reserve(n - 2);
+    for (const std::vector<std::size_t>& face : detail::Faces(ccw, detail::MonotoneDiagonals(ccw))) {
+        detail::TriangulateMonotone(ccw, face, triangles);
+    }
+    if (clockwise) {
+        for (Triangle& t : triangles) {
+            t = {n - 1 - t.a, n - 1 - t.b, n - 1 - t.c};
+        }
+    }
+    return triangles;
+}
+
+class TriangleLocator {
+public:
+    TriangleLocator(const std::vector<Point>& points, const std::vector<Triangle>& triangles) : points_(points) {
+        // ребро триангуляции - пара вершин (нижняя, верхняя); треугольник правее ребра тот,
+        // в котором обход против часовой стрелки проходит ребро сверху вниз
+        struct Side {
+            std::size_t lower;
+            std::size_t upper;
+            std::size_t triangle;
+            bool right;
+        };
+        std::vector<Side> sides;
+        for (std::size_t t = 0; t < triangles.size(); t++) {
+            const std::size_t v[3] = {triangles[t].a, triangles[t].b, triangles[t].c};
+            for (int i = 0; i < 3; i++) {
+                std::size_t p = v[i];
+                std::size_t q = v[(i + 1) % 3];
+                if (points[p].y == points[q].y) {
+                    continue;
+                }
+                bool down = points[p].y > points[q].y;
+                sides.push_back({down ? q : p, down ? p : q, t, down});
+            }
+        }
+        std::sort(sides.begin(), sides.end(), [](const Side& lhs, const Side& rhs) {
+            return lhs.lower != rhs.lower ? lhs.lower < rhs.lower : lhs.upper < rhs.upper;
+        });
+        for (std::size_t i = 0; i < sides.size(); i++) {
+            if (i == 0 || sides[i].lower != sides[i - 1].lower || sides[i].upper != sides[i - 1].upper) {
+                lower_.push_back(sides[i].lower);
+                upper_.push_back(sides[i].upper);
+                right_.push_back(kNone);
+            }
+            if (sides[i].right) {
+                right_.back() = sides[i].triangle;
+            }
+        }
+
+        for (const Point& p : points) {
+            ys_.push_back(p.y);
+        }
+        std::sort(ys_.begin(), ys_.end());
+        ys_.erase(std::unique(ys_.begin(), ys_.end()), ys_.end());
+        slabs_ = ys_.empty() ? 0 : ys_.size() - 1;
+        leaves_ = 1;
+        while (leaves_ < slabs_) {
+            leaves_ *= 2;
+        }
+
+        // ребро кладется в O(log n) узлов дерева отрезков над полосами, которые оно
+        // пересекает целиком: сначала считаем размеры узлов, потом раскладываем
+        offsets_.assign(2 * leaves_ + 1, 0);
+        ForEachNode([&](std::size_t node, std::size_t) { ++offsets_[node + 1]; });
+        for (std::size_t node = 0; node < 2 * leaves_; node++) {
+            offsets_[node + 1] += offsets_[node];
+        }
+        edges_.resize(offsets_[2 * leaves_]);
+        std::vector<std::size_t> filled(offsets_.begin(), offsets_.end() - 1);
+        ForEachNode([&](std::size_t node, std::size_t edge) {
+            edges_[filled[node]++] = static_cast<std::uint32_t>(edge);
+        });
+
+        // ребра узла не пересекаются на всей его высоте: порядок по x в середине - порядок везде
+        for (std::size_t node = 1; node < 2 * leaves_; node++) {
+            if (offsets_[node] == offsets_[node + 1]) {
+                continue;
+            }
+            std::size_t depth = 0;
+            while ((node >> (depth + 1)) != 0) {
+                ++depth;
+            }
+            std::size_t span = leaves_ >> depth;
+            std::size_t lo = (node - (std::size_t(1) << depth)) * span;
+            double middle = (ys_[lo] + ys_[std::min(lo + span, slabs_)]) / 2;
+            std::sort(edges_.begin() + offsets_[node], edges_.begin() + offsets_[node + 1],
+                      [&](std::uint32_t lhs, std::uint32_t rhs) { return X(lhs, middle) < X(rhs, middle); });
+        }
+    }
+
+    // номер треугольника с точкой p или kNone, если она снаружи.
+    // На пути от листа-полосы к корню в каждом узле ищем ближайшее ребро слева от p,
+    // ответ - треугольник правее ближайшего из них: O(log^2 n)
+    std::size_t Locate(const Point& p) const {
+        if (ys_.empty() || !(p.y >= ys_.front() && p.y < ys_.back())) {
+            return kNone;
+        }
+        std::size_t slab = std::upper_bound(ys_.begin(), ys_.end(), p.y) - ys_.begin() - 1;
+        std::size_t best = kNone;
+        double best_x = 0;
+        for (std::size_t node = slab + leaves_; node >= 1; node /= 2) {
+            std::size_t lo = offsets_[node];
+            std::size_t hi = offsets_[node + 1];
+            std::size_t begin = lo;
+            while (lo < hi) {
+                std::size_t mid = (lo + hi) / 2;
+                if (p.x < X(edges_[mid], p.y)) {
+                    hi = mid;
+                } else {
+                    lo = mid + 1;
+                }
+            }
+            if (lo != begin) {
+                double x = X(edges_[lo - 1], p.y);
+                if (best == kNone || x > best_x) {
+                    best = edges_[lo - 1];
+                    best_x = x;
+                }
+            }
+        }
+        return best == kNone ? kNone : right_[best];
+    }
+
+    // число ребер во всех узлах - размер индекса
+    std::size_t Entries() const {
+        return edges_.size();
+    }
+
+    constexpr static std::size_t kNone = static_cast<std::size_t>(-1);
+
+private:
+    // f(узел, ребро) для узлов, на которые разбивается отрезок полос ребра
+    template<typename F>
+    void ForEachNode(F f) const {
+        for (std::size_t edge = 0; edge < lower_.size(); edge++) {
+            std::size_t from = Slab(points_[lower_[edge]].y) + leaves_;
+            std::size_t to = Slab(points_[upper_[edge]].y) + leaves_;
+            for (; from < to; from /= 2, to /= 2) {
+                if (from % 2 == 1) {
+                    f(from++, edge);
+                }
+                if (to % 2 == 1) {
+                    f(--to, edge);
+                }
+            }
+        }
+    }
+
+    std::size_t Slab(double y) const {
+        return std::lower_bound(ys_.begin(), ys_.end(), y) - ys_.begin();
+    }
+
+    double X(std::uint32_t edge, double y) const {
+        return EdgeX(points_[lower_[edge]], points_[upper_[edge]], y);
+    }
+
+    std::vector<Point> points_;
+    std::vector<std::size_t> lower_;
+    std::vector<std::size_t> upper_;
+    std::vector<std::size_t> right_;
+    std::vector<double> ys_;
+    std::size_t slabs_;
+    std::size_t leaves_;
+    // ребра узла node - edges_[offsets_[node], offsets_[node + 1]), корень - узел 1
+    std::vector<std::size_t> offsets_;
+    std::vector<std::uint32_t> edges_;
+};
+
+bool TriangleContains(const std::vector<Point>& points, const Triangle& t, const Point& p) {
+    return Cross(points[t.a], points[t.b], p) >= 0 && Cross(points[t.b], points[t.c], p) >= 0 &&
+           Cross(points[t.c], points[t.a], p) >= 0;
+}
+
+// перебор всех треугольников, O(n)
+std::size_t ScanLocate(const std::vector<Point>& points, const std::vector<Triangle>& triangles, const Point& p) {
+    for (std::size_t t = 0; t < triangles.size(); t++) {
+        if (TriangleContains(points, triangles[t], p)) {
+            return t;
+        }
+    }
+    return TriangleLocator::kNone;
+}
+
+// n - 2 невырожденных треугольника, сумма площадей равна площади многоугольника
+bool CheckTriangulation(const std::vector<Point>& polygon, const std::vector<Triangle>& triangles) {
+    if (triangles.size() != polygon.size() - 2) {
+        return false;
+    }
+    double sum = 0;
+    for (const Triangle& t : triangles) {
+        double doubled = Cross(polygon[t.a], polygon[t.b], polygon[t.c]);
+        if (!(doubled > 0)) {
+            return false;
+        }
+        sum += doubled / 2;
+    }
+    double area = std::fabs(SignedArea(polygon));
+    return std::fabs(sum - area) <= 1e-9 * area;
+}
+
+// звездный многоугольник: вершины по углу, радиус в [inner, 1]; малый inner - много расщеплений
+std::vector<Point> Star(std::size_t n, double inner, std::mt19937& gen) {
+    std::uniform_real_distribution<double> radius(inner, 1);
+    std::vector<Point> polygon(n);
+    for (std::size_t i = 0; i < n; i++) {
+        double phi = 2 * 3.14159265358979323846 * i / n;
+        double r = radius(gen);
+        polygon[i] = {r * std::cos(phi), r * std::sin(phi)};
+    }
+    return polygon;
+}
+
+// гребенка: горизонтальные ребра и много вершин на одной высоте
+std::vector<Point> Comb(std::size_t teeth) {
+    double width = 2.0 * teeth - 1;
+    std::vector<Point> polygon = {{0, 0}, {width, 0}};
+    for (std::size_t i = teeth; i-- > 0;) {
+        polygon.push_back({2.0 * i + 1, 10});
+        polygon.push_back({2.0 * i, 10});
+        if (i > 0) {
+            polygon.push_back({2.0 * i, 1});
+            polygon.push_back({2.0 * i - 1, 1});
+        }
+    }
+    return polygon;
+}
+
+template<typename F>
+auto Measure(const char* name, std::size_t count, F f) {
+    auto start = std::chrono::steady_clock::now();
+    auto result = f();
+    auto finish = std::chrono::steady_clock::now();
+    std::cout << name << ": " << std::chrono::duration<double, std::nano>(finish - start).count() / count
+              << " ns/op" << std::endl;
+    return result;
+}
+
+int main() {
+    std::mt19937 gen(42);
+    bool ok = true;
+
+    // многоугольник из теста Area.TrianglePolygons и гребенка по часовой стрелке
+    std::vector<Point> quad = {{1, 0}, {0, 1}, {1, 1.5}, {2, 1}};
+    std::vector<Point> comb = Comb(50);
+    std::reverse(comb.begin(), comb.end());
+    std::size_t small_failures = !CheckTriangulation(quad, Triangulate(quad)) + !CheckTriangulation(comb, Triangulate(comb));
+    // случайные звезды: все сочетания вершин-расщеплений и слияний на малых n
+    for (int trial = 0; trial < 20000; trial++) {
+        std::vector<Point> star = Star(3 + trial % 40, std::uniform_real_distribution<double>(0, 1)(gen), gen);
+        small_failures += !CheckTriangulation(star, Triangulate(star));
+    }
+    std::cout << "small polygons failed: " << small_failures << std::endl;
+    ok = ok && small_failures == 0;
+
+    const std::size_t n = 100000;
+    const std::size_t queries = 1000000;
+    std::uniform_real_distribution<double> unit(-1.1, 1.1);
+    std::vector<Point> points(queries);
+    for (Point& p : points) {
+        p = {unit(gen), unit(gen)};
+    }
+    struct Case {
+        const char* name;
+        double inner;
+    };
+    for (const Case& test : {Case{"almost convex, 10^5 vertices", 0.99999}, Case{"hedgehog, 10^5 vertices", 0.1}}) {
+        std::cout << "--- " << test.name << std::endl;
+        std::vector<Point> polygon = Star(n, test.inner, gen);
+        std::vector<Triangle> triangles = Measure("triangulate", n, [&] { return Triangulate(polygon); });
+        bool valid = CheckTriangulation(polygon, triangles);
+        std::cout << "triangles: " << triangles.size() << ", areas " << (valid ? "match" : "differ") << std::endl;
+        ok = ok && valid;
+
+        TriangleLocator locator = Measure("build locator", n, [&] { return TriangleLocator(polygon, triangles); });
+        std::cout << "locator entries: " << locator.Entries() << " (" << double(locator.Entries()) / n
+                  << " per vertex)" << std::endl;
+        std::vector<std::size_t> located(queries);
+        Measure("TriangleLocator::Locate", queries, [&] {
+            for (std::size_t i = 0; i < queries; i++) {
+                located[i] = locator.Locate(points[i]);
+            }
+            return 0;
+        });
+        // перебор слишком долгий на всех запросах, берем тысячную часть
+        std::size_t checked = queries / 1000;
+        std::vector<std::size_t> scanned(checked);
+        Measure("scan over triangles, O(n)", checked, [&] {
+            for (std::size_t i = 0; i < checked; i++) {
+                scanned[i] = ScanLocate(polygon, triangles, points[i]);
+            }
+            return 0;
+        });
+        // на общем ребре точка лежит в двух треугольниках, поэтому сравниваем не номера, а попадание
+        std::size_t disagree = 0;
+        for (std::size_t i = 0; i < checked; i++) {
+            bool inside = located[i] != TriangleLocator::kNone;
+            disagree += inside != (scanned[i] != TriangleLocator::kNone) ||
+                        (inside && !TriangleContains(polygon, triangles[located[i]], points[i]));
+        }
+        std::cout << "inside: " << queries - std::count(located.begin(), located.end(), TriangleLocator::kNone)
+                  << ", scan disagrees on " << disagree << " of " << checked << std::endl;
+        ok = ok && disagree == 0;
+    }
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,467 @@
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <iostream>
+#include <mutex>
+#include <random>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+// Площади и принадлежность точки для большого набора фигур разной стоимости в нескольких потоках:
+// * WorkStealingPool - у каждого потока своя очередь задач; свои задачи берутся с конца,
+//   а опустевший поток крадет из начала чужой очереди. Вызывающий поток работает вместе с пулом
+// * MakeTasks - куски примерно равной стоимости (число вершин): мелкие фигуры идут пачками,
+//   многоугольник дороже куска режется на отрезки вершин, их частичные суммы складываются потом.
+//   Разбиение зависит только от набора фигур, его строят один раз на все запросы
+// * ParallelAreas / ParallelContains - площадь каждой фигуры и попадание точки в каждую
+// Деление поровну по числу фигур здесь плохо работает: многоугольник на 10^5 вершин стоит
+// столько же, сколько 10^4 кругов, и весь достается одному потоку.
+// Когда иерархия будет реализована, эти функции смогут принимать Shape из homework/Geometry.
+
+struct Point {
+    double x;
+    double y;
+};
+
+// круг, если polygon пуст
+struct Item {
+    std::vector<Point> polygon;
+    Point center;
+    double radius;
+};
+
+std::size_t Cost(const Item& item) {
+    return item.polygon.empty() ? 1 : item.polygon.size();
+}
+
+// удвоенная ориентированная площадь по ребрам i -> i + 1 для i из [from, to)
+double ShoelacePart(const std::vector<Point>& polygon, std::size_t from, std::size_t to) {
+    double sum = 0;
+    for (std::size_t i = from; i < to; i++) {
+        const Point& a = polygon[i];
+        const Point& b = polygon[i + 1 == polygon.size() ? 0 : i + 1];
+        sum += a.x * b.y - b.x * a.y;
+    }
+    return sum;
+}
+
+double Area(const Item& item) {
+    if (item.polygon.empty()) {
+        return 3.14159265358979323846 * item.radius * item.radius;
+    }
+    return std::fabs(ShoelacePart(item.polygon, 0, item.polygon.size())) / 2;
+}
+
+// четность пересечений луча вправо из p с ребрами i -> i + 1 для i из [from, to)
+bool CrossingsPart(const std::vector<Point>& polygon, std::size_t from, std::size_t to, const Point& p) {
+    bool odd = false;
+    for (std::size_t i = from; i < to; i++) {
+        const Point& a = polygon[i];
+        const Point& b = polygon[i + 1 == polygon.size() ? 0 : i + 1];
+        if ((a.y > p.y) != (b.y > p.y) && p.x < a.x + (p.y - a.y) * (b.x - a.x) / (b.y - a.y)) {
+            odd = !odd;
+        }
+    }
+    return odd;
+}
+
+bool Contains(const Item& item, const Point& p) {
+    if (item.polygon.empty()) {
+        double dx = p.x - item.center.x;
+        double dy = p.y - item.center.y;
+        return dx * dx + dy * dy <= item.radius * item.radius;
+    }
+    return CrossingsPart(item.polygon, 0, item.polygon.size(), p);
+}
+
+class WorkStealingPool {
+public:
+    // threads - всего потоков вместе с вызывающим
+    explicit WorkStealingPool(unsigned threads) : queues_(std::max(1u, threads)) {
+        for (unsigned self = 1; self < queues_.size(); self++) {
+            workers_.emplace_back([this, self] { Serve(self); });
+        }
+    }
+
+    WorkStealingPool(const WorkStealingPool&) = delete;
+    WorkStealingPool& operator=(const WorkStealingPool&) = delete;
+
+    ~WorkStealingPool() {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            stop_ = true;
+        }
+        wake_.notify_all();
+        for (std::thread& worker : workers_) {
+            worker.join();
+        }
+    }
+
+    unsigned Threads() const {
+        return queues_.size();
+    }
+
+    // Вызывает job(0) ... job(tasks - 1) и ждет всех. Задачи раздаются очередям подряд идущими
+    // блоками; первое исключение из задачи бросается здесь, остальные задачи все равно выполняются
+    void Run(std::size_t tasks, std::function<void(std::size_t)> job) {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            job_ = std::move(job);
+            remaining_ = tasks;
+            std::size_t block = (tasks + queues_.size() - 1) / queues_.size();
+            for (std::size_t q = 0; q < queues_.size(); q++) {
+                std::lock_guard<std::mutex> queue_lock(queues_[q].mutex);
+                for (std::size_t task = q * block; task < std::min(tasks, (q + 1) * block); task++) {
+                    queues_[q].tasks.push_back(task);
+                }
+            }
+            ++generation_;
+        }
+        wake_.notify_all();
+        Drain(0);
+
+        std::unique_lock<std::mutex> lock(mutex_);
+        done_.wait(lock, [this] { return remaining_ == 0 && active_ == 0; });
+        if (error_) {
+            std::exception_ptr error = error_;
+            error_ = nullptr;
+            std::rethrow_exception(error);
+        }
+    }
+
+private:
+    struct Queue {
+        std::mutex mutex;
+        std::deque<std::size_t> tasks;
+    };
+
+    // очереди под мьютексами, а не lock-free деки Чейза-Лева: задачи крупные,
+    // и на блокировку уходит малая доля времени
+    bool Pop(unsigned self, std::size_t& task) {
+        for (std::size_t k = 0; k < queues_.size(); k++) {
+            Queue& queue = queues_[(self + k) % queues_.size()];
+            std::lock_guard<std::mutex> lock(queue.mutex);
+            if (!queue.tasks.empty()) {
+                if (k == 0) {
+                    task = queue.tasks.back();
+                    queue.tasks.pop_back();
+                } else {
+                    task = queue.tasks.front();
+                    queue.tasks.pop_front();
+                }
+                return true;
+            }
+        }
+        return false;
+    }
+
+    // новые задачи не порождаются, поэтому пустые очереди значат, что брать больше нечего
+    void Drain(unsigned self) {
+        std::size_t task;
+        while (Pop(self, task)) {
+            try {
+                job_(task);
+            } catch (...) {
+                std::lock_guard<std::mutex> lock(mutex_);
+                if (!error_) {
+                    error_ = std::current_exception();
+                }
+            }
+            if (--remaining_ == 0) {
+                std::lock_guard<std::mutex> lock(mutex_);
+                done_.notify_all();
+            }
+        }
+    }
+
+    // active_ не дает Run вернуться, пока поток внутри Drain читает job_
+    void Serve(unsigned self) {
+        std::size_t seen = 0;
+        while (true) {
+            {
+                std::unique_lock<std::mutex> lock(mutex_);
+                wake_.wait(lock, [&] { return stop_ || generation_ != seen; });
+                if (stop_) {
+                    return;
+                }
+                seen = generation_;
+                ++active_;
+            }
+            Drain(self);
+            std::lock_guard<std::mutex> lock(mutex_);
+            --active_;
+            done_.notify_all();
+        }
+    }
+
+    std::vector<Queue> queues_;
+    std::vector<std::thread> workers_;
+    std::mutex mutex_;
+    std::condition_variable wake_;
+    std::condition_variable done_;
+    std::function<void(std::size_t)> job_;
+    std::atomic<std::size_t> remaining_{0};
+    std::size_t generation_ = 0;
+    std::size_t active_ = 0;
+    bool stop_ = false;
+    std::exception_ptr error_;
+};
+
+// Задача - либо фигуры [first, last) целиком, либо вершины [from, to) одного многоугольника first
+struct Task {
+    std::size_t first;
+    std::size_t last;
+    std::size_t from;
+    std::size_t to;
+
+    bool IsPart() const {
+        return to != 0;
+    }
+};
+
+std::size_t Grain(const std::vector<Item>& items, unsigned threads) {
+    const std::size_t kTasksPerThread = 16;
+    const std::size_t kMinGrain = 4096;
+    std::size_t total = 0;
+    for (const Item& item : items) {
+        total += Cost(item);
+    }
+    return std::max(kMinGrain, total / (threads * kTasksPerThread));
+}
+
+// куски стоимостью около grain; кусков на поток с запасом, чтобы было что красть
+std::vector<Task> MakeTasks(const std::vector<Item>& items, unsigned threads) {
+    std::size_t grain = Grain(items, threads);
+    std::vector<Task> tasks;
+    std::size_t run_start = 0;
+    std::size_t run_cost = 0;
+    for (std::size_t i = 0; i < items.size(); i++) {
+        std::size_t cost = Cost(items[i]);
+        if (run_cost != 0 && (run_cost + cost > grain || cost > grain)) {
+            tasks.push_back({run_start, i, 0, 0});
+            run_start = i;
+            run_cost = 0;
+        }
+        if (cost > grain) {
+            for (std::size_t from = 0; from < cost; from += grain) {
+                tasks.push_back({i, i + 1, from, std::min(cost, from + grain)});
+            }
+            run_start = i + 1;
+            continue;
+        }
+        run_cost += cost;
+    }
+    if (run_start < items.size()) {
+        tasks.push_back({run_start, items.size(), 0, 0});
+    }
+    return tasks;
+}
+
+std::vector<double> ParallelAreas(WorkStealingPool& pool, const std::vector<Item>& items,
+                                  const std::vector<Task>& tasks) {
+    std::vector<double> areas(items.size());
+    std::vector<double> parts(tasks.size());
+    pool.Run(tasks.size(), [&](std::size_t t) {
+        const Task& task = tasks[t];
+        if (task.IsPart()) {
+            parts[t] = ShoelacePart(items[task.first].polygon, task.from, task.to);
+            return;
+        }
+        for (std::size_t i = task.first; i < task.last; i++) {
+            areas[i] = Area(items[i]);
+        }
+    });
+    // части одного многоугольника идут подряд
+    for (std::size_t t = 0; t < tasks.size();) {
+        if (!tasks[t].IsPart()) {
+            ++t;
+            continue;
+        }
+        std::size_t item = tasks[t].first;
+        double sum = 0;
+        for (; t < tasks.size() && tasks[t].IsPart() && tasks[t].first == item; t++) {
+            sum += parts[t];
+        }
+        areas[item] = std::fabs(sum) / 2;
+    }
+    return areas;
+}
+
+// байты, а не std::vector<bool>: задачи пишут в соседние элементы из разных потоков
+std::vector<std::uint8_t> ParallelContains(WorkStealingPool& pool, const std::vector<Item>& items,
+                                           const std::vector<Task>& tasks, const Point& p) {
+    std::vector<std::uint8_t> inside(items.size());
+    std::vector<std::uint8_t> parts(tasks.size());
+    pool.Run(tasks.size(), [&](std::size_t t) {
+        const Task& task = tasks[t];
+        if (task.IsPart()) {
+            parts[t] = CrossingsPart(items[task.first].polygon, task.from, task.to, p);
+            return;
+        }
+        for (std::size_t i = task.first; i < task.last; i++) {
+            inside[i] = Contains(items[i], p);
+        }
+    });
+    for (std::size_t t = 0; t < tasks.size(); t++) {
+        if (tasks[t].IsPart()) {
+            inside[tasks[t].first] ^= parts[t];
+        }
+    }
+    return inside;
+}
+
+// для сравнения: std::thread на равные по числу фигур блоки
+std::vector<double> StaticAreas(const std::vector<Item>& items, unsigned threads) {
+    std::vector<double> areas(items.size());
+    std::size_t block = (items.size() + threads - 1) / threads;
+    std::vector<std::thread> workers;
+    for (std::size_t from = 0; from < items.size(); from += block) {
+        workers.emplace_back([&, from] {
+            for (std::size_t i = from; i < std::min(items.size(), from + block); i++) {
+                areas[i] = Area(items[i]);
+            }
+        });
+    }
+    for (std::thread& worker : workers) {
+        worker.join();
+    }
+    return areas;
+}
+
+// отношение самой нагруженной доли к средней: предел ускорения на threads ядрах - threads / оно
+double StaticImbalance(const std::vector<Item>& items, unsigned threads) {
+    std::size_t block = (items.size() + threads - 1) / threads;
+    std::vector<double> load(threads);
+    double total = 0;
+    for (std::size_t i = 0; i < items.size(); i++) {
+        load[i / block] += Cost(items[i]);
+        total += Cost(items[i]);
+    }
+    return *std::max_element(load.begin(), load.end()) / (total / threads);
+}
+
+double LargestTaskShare(const std::vector<Item>& items, unsigned threads) {
+    std::vector<Task> tasks = MakeTasks(items, threads);
+    double total = 0;
+    double largest = 0;
+    for (const Task& task : tasks) {
+        double cost = 0;
+        if (task.IsPart()) {
+            cost = task.to - task.from;
+        } else {
+            for (std::size_t i = task.first; i < task.last; i++) {
+                cost += Cost(items[i]);
+            }
+        }
+        total += cost;
+        largest = std::max(largest, cost);
+    }
+    return largest / (total / threads);
+}
+
+// звездный многоугольник с центром center
+std::vector<Point> Star(std::size_t n, Point center, double size, std::mt19937& gen) {
+    std::uniform_real_distribution<double> radius(0.5 * size, size);
+    std::vector<Point> polygon(n);
+    for (std::size_t i = 0; i < n; i++) {
+        double phi = 2 * 3.14159265358979323846 * i / n;
+        double r = radius(gen);
+        polygon[i] = {center.x + r * std::cos(phi), center.y + r * std::sin(phi)};
+    }
+    return polygon;
+}
+
+template<typename F>
+auto Measure(const char* name, unsigned threads, F f) {
+    auto start = std::chrono::steady_clock::now();
+    auto result = f();
+    auto finish = std::chrono::steady_clock::now();
+    std::cout << name << ", " << threads << " threads: "
+              << std::chrono::duration<double, std::milli>(finish - start).count() << " ms" << std::endl;
+    return result;
+}
+
+int main(int argc, char** argv) {
+    // work_stealing [потоков]: по умолчанию все ядра, замеры для 1, 2, 4, ... до этого числа
+    unsigned max_threads = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : std::thread::hardware_concurrency();
+    max_threads = std::max(1u, max_threads);
+
+    // 10^6 фигур: круги и многоугольники до 20 вершин, а подряд в середине -
+    // 20 многоугольников по 10^5 вершин, на которые приходится половина всей работы
+    std::mt19937 gen(42);
+    std::uniform_real_distribution<double> coord(-100, 100);
+    std::vector<Item> items;
+    for (std::size_t i = 0; i < 1000000; i++) {
+        Point center = {coord(gen), coord(gen)};
+        if (i >= 500000 && i < 500020) {
+            items.push_back({Star(100000, center, 50, gen), center, 0});
+        } else if (i % 2 == 0) {
+            items.push_back({{}, center, 1 + gen() % 10 / 10.0});
+        } else {
+            items.push_back({Star(3 + gen() % 18, center, 1, gen), center, 0});
+        }
+    }
+
+    std::vector<double> expected_areas(items.size());
+    std::vector<std::uint8_t> expected_inside(items.size());
+    Point query = {0, 0};
+    Measure("sequential area + contains", 1, [&] {
+        for (std::size_t i = 0; i < items.size(); i++) {
+            expected_areas[i] = Area(items[i]);
+            expected_inside[i] = Contains(items[i], query);
+        }
+        return 0;
+    });
+
+    bool ok = true;
+    for (unsigned threads = 1; threads <= max_threads; threads *= 2) {
+        WorkStealingPool pool(threads);
+        std::vector<Task> tasks = Measure("MakeTasks", threads, [&] { return MakeTasks(items, threads); });
+        std::vector<double> areas = Measure("ParallelAreas", threads, [&] {
+            return ParallelAreas(pool, items, tasks);
+        });
+        std::vector<std::uint8_t> inside = Measure("ParallelContains", threads, [&] {
+            return ParallelContains(pool, items, tasks, query);
+        });
+        std::vector<double> static_areas = Measure("equal blocks by count", threads, [&] {
+            return StaticAreas(items, threads);
+        });
+        // у разрезанных многоугольников суммы складываются в другом порядке
+        for (std::size_t i = 0; i < items.size(); i++) {
+            ok = ok && std::fabs(areas[i] - expected_areas[i]) <= 1e-9 * expected_areas[i];
+        }
+        ok = ok && inside == expected_inside && static_areas == expected_areas;
+    }
+
+    // баланс не зависит от числа ядер машины: считаем его по стоимости кусков
+    for (unsigned threads : {4u, 8u, 16u, 32u}) {
+        std::cout << threads << " threads: equal blocks load max / mean " << StaticImbalance(items, threads)
+                  << ", largest work-stealing task / mean load " << LargestTaskShare(items, threads) << std::endl;
+    }
+
+    // исключение из задачи доходит до вызывающего, пул остается рабочим
+    WorkStealingPool pool(std::min(max_threads, 4u));
+    bool caught = false;
+    try {
+        pool.Run(100, [](std::size_t task) {
+            if (task == 42) {
+                throw std::runtime_error("task 42");
+            }
+        });
+    } catch (const std::runtime_error&) {
+        caught = true;
+    }
+    std::vector<Task> tasks = MakeTasks(items, pool.Threads());
+    ok = ok && caught && ParallelAreas(pool, items, tasks) == ParallelAreas(pool, items, tasks);
+    std::cout << (ok ? "ok" : "mismatch") << std::endl;
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,482 @@
+#include <algorithm>
+#include <bitset>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define BITS_HAVE_AVX2 1
+#else
+#define BITS_HAVE_AVX2 0
+#endif
+
+// Операции над большими массивами битов, выросшие из bitwise_operation.cpp
+// (там биты печатаются сдвигом по одному и через std::bitset<16>::to_string):
+// * Popcount - число единиц
+// * Reverse - массив битов задом наперед
+// * ToText / FromText - биты в строку из '0' и '1' (старший бит байта первым) и обратно
+// * RankSelect - число единиц до позиции и позиция k-й единицы
+// Есть две реализации: переносимая (таблицы на 256 значений) и AVX2, где таблицы
+// на 16 значений (по полубайту) применяет pshufb сразу к 32 байтам.
+// Нужная выбирается при запуске по __builtin_cpu_supports, флаги компилятора не нужны.
+
+namespace bits {
+
+namespace portable {
+    struct Tables {
+        std::uint8_t reverse[256];
+        char text[256][8];
+
+        Tables() {
+            for (int byte = 0; byte < 256; byte++) {
+                reverse[byte] = 0;
+                for (int bit = 0; bit < 8; bit++) {
+                    reverse[byte] |= ((byte >> bit) & 1) << (7 - bit);
+                    text[byte][bit] = '0' + ((byte >> (7 - bit)) & 1);
+                }
+            }
+        }
+    };
+
+    const Tables kTables;
+
+    std::uint64_t Popcount(const std::uint8_t* data, std::size_t size) {
+        std::uint64_t count = 0;
+        std::size_t i = 0;
+        for (; i + 8 <= size; i += 8) {
+            std::uint64_t word;
+            std::memcpy(&word, data + i, sizeof(word));
+            count += __builtin_popcountll(word);
+        }
+        for (; i < size; i++) {
+            count += __builtin_popcount(data[i]);
+        }
+        return count;
+    }
+
+    // out[i] - байт in[size - 1 - i] с битами в обратном порядке
+    void Reverse(const std::uint8_t* in, std::size_t size, std::uint8_t* out) {
+        for (std::size_t i = 0; i < size; i++) {
+            out[i] = kTables.reverse[in[size - 1 - i]];
+        }
+    }
+
+    // 8 * size символов
+    void ToText(const std::uint8_t* in, std::size_t size, char* out) {
+        for (std::size_t i = 0; i < size; i++) {
+            std::memcpy(out + 8 * i, kTables.text[in[i]], 8);
+        }
+    }
+
+    // 8 * size символов; все, кроме '1', читается как 0
+    void FromText(const char* in, std::size_t size, std::uint8_t* out) {
+        for (std::size_t i = 0; i < size; i++) {
+            std::uint8_t byte = 0;
+            for (int bit = 0; bit < 8; bit++) {
+                byte = (byte << 1) | (in[8 * i + bit] == '1');
+            }
+            out[i] = byte;
+        }
+    }
+}
+
+#if BITS_HAVE_AVX2
+namespace avx2 {
+    // число единиц в каждом полубайте 0..15
+    __attribute__((target("avx2")))
+    __m256i NibbleCounts() {
+        return _mm256_setr_epi8(0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4,
+                                0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4);
+    }
+
+    // полубайт 0..15 с битами в обратном порядке
+    __attribute__((target("avx2")))
+    __m256i NibbleReverse() {
+        return _mm256_setr_epi8(0x0, 0x8, 0x4, 0xC, 0x2, 0xA, 0x6, 0xE, 0x1, 0x9, 0x5, 0xD, 0x3, 0xB, 0x7, 0xF,
+                                0x0, 0x8, 0x4, 0xC, 0x2, 0xA, 0x6, 0xE, 0x1, 0x9, 0x5, 0xD, 0x3, 0xB, 0x7, 0xF);
+    }
+
+    // pshufb по младшим и старшим полубайтам, суммы байтов - через psadbw
+    __attribute__((target("avx2")))
+    std::uint64_t Popcount(const std::uint8_t* data, std::size_t size) {
+        const __m256i counts = NibbleCounts();
+        const __m256i low_mask = _mm256_set1_epi8(0x0F);
+        __m256i total = _mm256_setzero_si256();
+        std::size_t i = 0;
+        for (; i + 32 <= size; i += 32) {
+            __m256i chunk = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i));
+            __m256i low = _mm256_and_si256(chunk, low_mask);
+            __m256i high = _mm256_and_si256(_mm256_srli_epi16(chunk, 4), low_mask);
+            __m256i bytes = _mm256_add_epi8(_mm256_shuffle_epi8(counts, low), _mm256_shuffle_epi8(counts, high));
+            total = _mm256_add_epi64(total, _mm256_sad_epu8(bytes, _mm256_setzero_si256()));
+        }
+        std::uint64_t lanes[4];
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(lanes), total);
+        return lanes[0] + lanes[1] + lanes[2] + lanes[3] + portable::Popcount(data + i, size - i);
+    }
+
+    // биты в каждом байте - через таблицу полубайтов, порядок байтов -
+    // pshufb внутри 128-битных половин и перестановка половин
+    __attribute__((target("avx2")))
+    void Reverse(const std::uint8_t* in, std::size_t size, std::uint8_t* out) {
+        const __m256i reverse = NibbleReverse();
+        const __m256i low_mask = _mm256_set1_epi8(0x0F);
+        const __m256i byte_order = _mm256_setr_epi8(15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1, 0,
+                                                    15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1, 0);
+        std::size_t i = 0;
+        for (; i + 32 <= size; i += 32) {
+            __m256i chunk = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(in + size - 32 - i));
+            __m256i low = _mm256_shuffle_epi8(reverse, _mm256_and_si256(chunk, low_mask));
+            __m256i high = _mm256_shuffle_epi8(reverse, _mm256_and_si256(_mm256_srli_epi16(chunk, 4), low_mask));
+            __m256i bytes = _mm256_or_si256(_mm256_slli_epi16(low, 4), high);
+            bytes = _mm256_permute4x64_epi64(_mm256_shuffle_epi8(bytes, byte_order), 0x4E);
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i), bytes);
+        }
+        portable::Reverse(in, size - i, out + i);
+    }
+
+    // 4 байта -> 32 символа: каждый байт размножается на 8 позиций,
+    // и в каждой позиции проверяется свой бит
+    __attribute__((target("avx2")))
+    void ToText(const std::uint8_t* in, std::size_t size, char* out) {
+        const __m256i spread = _mm256_setr_epi8(0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 1, 1, 1, 1,
+                                                2, 2, 2, 2, 2, 2, 2, 2, 3, 3, 3, 3, 3, 3, 3, 3);
+        const __m256i bit = _mm256_set1_epi64x(0x0102040810204080ll);
+        const __m256i zero = _mm256_set1_epi8('0');
+        std::size_t i = 0;
+        for (; i + 4 <= size; i += 4) {
+            std::int32_t word;
+            std::memcpy(&word, in + i, sizeof(word));
+            __m256i bytes = _mm256_shuffle_epi8(_mm256_set1_epi32(word), spread);
+            __m256i set = _mm256_cmpeq_epi8(_mm256_and_si256(bytes, bit), bit);
+            // set = -1 там, где бит есть: '0' - (-1) = '1'
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + 8 * i), _mm256_sub_epi8(zero, set));
+        }
+        portable::ToText(in + i, size - i, out + 8 * i);
+    }
+
+    // 32 символа -> 4 байта: сравнение с '1' и movemask; movemask кладет первый
+    // символ в младший бит, поэтому символы в каждой восьмерке сначала разворачиваются
+    __attribute__((target("avx2")))
+    void FromText(const char* in, std::size_t size, std::uint8_t* out) {
+        const __m256i one = _mm256_set1_epi8('1');
+        const __m256i group_order = _mm256_setr_epi8(7, 6, 5, 4, 3, 2, 1, 0, 15, 14, 13, 12, 11, 10, 9, 8,
+                                                     7, 6, 5, 4, 3, 2, 1, 0, 15, 14, 13, 12, 11, 10, 9, 8);
+        std::size_t i = 0;
+        for (; i + 4 <= size; i += 4) {
+            __m256i chars = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(in + 8 * i));
+            __m256i set = _mm256_shuffle_epi8(_mm256_cmpeq_epi8(chars, one), group_order);
+            std::uint32_t word = static_cast<std::uint32_t>(_mm256_movemask_epi8(set));
+            std::memcpy(out + i, &word, sizeof(word));
+        }
+        portable::FromText(in + 8 * i, size - i, out + i);
+    }
+}
+#endif
+
+// выбранная при запуске реализация
+struct Implementation {
+    const char* name;
+    std::uint64_t (*popcount)(const std::uint8_t*, std::size_t);
+    void (*reverse)(const std::uint8_t*, std::size_t, std::uint8_t*);
+    void (*to_text)(const std::uint8_t*, std::size_t, char*);
+    void (*from_text)(const char*, std::size_t, std::uint8_t*);
+};
+
+const Implementation kPortable = {"portable", &portable::Popcount, &portable::Reverse, &portable::ToText,
+                                  &portable::FromText};
+
+Implementation Detect() {
+#if BITS_HAVE_AVX2
+    // вызывается из статической инициализации, до нее cpu_init мог не отработать
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2")) {
+        return {"avx2", &avx2::Popcount, &avx2::Reverse, &avx2::ToText, &avx2::FromText};
+    }
+#endif
+    return kPortable;
+}
+
+const Implementation kBest = Detect();
+
+std::uint64_t Popcount(const std::uint8_t* data, std::size_t size) {
+    return kBest.popcount(data, size);
+}
+
+void Reverse(const std::uint8_t* in, std::size_t size, std::uint8_t* out) {
+    kBest.reverse(in, size, out);
+}
+
+void ToText(const std::uint8_t* in, std::size_t size, char* out) {
+    kBest.to_text(in, size, out);
+}
+
+void FromText(const char* in, std::size_t size, std::uint8_t* out) {
+    kBest.from_text(in, size, out);
+}
+
+// Rank / select над массивом 64-битных слов (бит i - бит i % 64 слова i / 64).
+// На каждые 512 бит хранится число единиц до них: +12.5% памяти,
+// rank - одно чтение счетчика и до 8 popcount, select - бинарный поиск по счетчикам
+class RankSelect {
+public:
+    RankSelect(const std::uint64_t* words, std::size_t num_words) : words_(words), num_words_(num_words) {
+        std::uint64_t ones = 0;
+        for (std::size_t word = 0; word < num_words; word++) {
+            if (word % kWordsPerBlock == 0) {
+                blocks_.push_back(ones);
+            }
+            ones += __builtin_popcountll(words[word]);
+        }
+        // граница: Rank(64 * num_words) при num_words % 8 == 0 читает блок за последним
+        blocks_.push_back(ones);
+        ones_ = ones;
+    }
+
+    // число единиц среди битов [0, pos), pos <= 64 * num_words
+    std::uint64_t Rank(std::uint64_t pos) const {
+        std::size_t word = pos / 64;
+        std::uint64_t ones = blocks_[word / kWordsPerBlock];
+        for (std::size_t i = word / kWordsPerBlock * kWordsPerBlock; i < word; i++) {
+            ones += __builtin_popcountll(words_[i]);
+        }
+        if (pos % 64 != 0) {
+            ones += __builtin_popcountll(words_[word] << (64 - pos % 64));
+        }
+        return ones;
+    }
+
+    // позиция единицы с номером k (с нуля); k < Ones()
+    std::uint64_t Select(std::uint64_t k) const {
+        std::size_t block = std::upper_bound(blocks_.begin(), blocks_.end(), k) - blocks_.begin() - 1;
+        k -= blocks_[block];
+        std::size_t word = block * kWordsPerBlock;
+        while (true) {
+            std::uint64_t ones = __builtin_popcountll(words_[word]);
+            if (k < ones) {
+                break;
+            }
+            k -= ones;
+            ++word;
+        }
+        return 64 * word + SelectInWord(words_[word], k);
+    }
+
+    std::uint64_t Ones() const {
+        return ones_;
+    }
+
+private:
+    const static std::size_t kWordsPerBlock = 8;
+
+    // сначала нужный байт по popcount байтов, потом бит внутри него
+    static unsigned SelectInWord(std::uint64_t word, std::uint64_t k) {
+        unsigned shift = 0;
+        while (true) {
+            unsigned ones = __builtin_popcount(static_cast<unsigned>(word & 0xFF));
+            if (k < ones) {
+                break;
+            }
+            k -= ones;
+            word >>= 8;
+            shift += 8;
+        }
+        for (; k > 0; k--) {
+            word &= word - 1;
+        }
+        return shift + __builtin_ctzll(word);
+    }
+
+    const std::uint64_t* words_;
+    std::size_t num_words_;
+    std::vector<std::uint64_t> blocks_;
+    std::uint64_t ones_;
+};
+
+}  // namespace bits
+
+// как в bitwise_operation.cpp: по одному биту сдвигом
+namespace shifts {
+    std::uint64_t Popcount(const std::uint8_t* data, std::size_t size) {
+        std::uint64_t count = 0;
+        for (std::size_t i = 0; i < size; i++) {
+            for (int bit = 7; bit >= 0; bit--) {
+                count += (data[i] >> bit) & 1;
+            }
+        }
+        return count;
+    }
+
+    void Reverse(const std::uint8_t* in, std::size_t size, std::uint8_t* out) {
+        for (std::size_t i = 0; i < size; i++) {
+            std::uint8_t byte = 0;
+            for (int bit = 0; bit < 8; bit++) {
+                byte |= ((in[size - 1 - i] >> bit) & 1) << (7 - bit);
+            }
+            out[i] = byte;
+        }
+    }
+
+    void ToText(const std::uint8_t* in, std::size_t size, char* out) {
+        for (std::size_t i = 0; i < size; i++) {
+            for (int bit = 7; bit >= 0; bit--) {
+                *out++ = '0' + ((in[i] >> bit) & 1);
+            }
+        }
+    }
+}
+
+template<typename F>
+std::uint64_t Measure(const char* name, std::size_t bytes, F f) {
+    auto start = std::chrono::steady_clock::now();
+    std::uint64_t result = f();
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    std::cout << name << ": " << bytes / seconds / (1 << 30) << " GB/s (" << result << ")" << std::endl;
+    return result;
+}
+
+template<typename F>
+std::uint64_t MeasureQueries(const char* name, std::size_t queries, F f) {
+    auto start = std::chrono::steady_clock::now();
+    std::uint64_t result = f();
+    auto finish = std::chrono::steady_clock::now();
+    std::cout << name << ": " << std::chrono::duration<double, std::nano>(finish - start).count() / queries
+              << " ns/query (" << result << ")" << std::endl;
+    return result;
+}
+
+int main(int argc, char** argv) {
+    // размер в мегабайтах: bit_toolkit [size], по умолчанию 32 МБ - больше кэша, но пик памяти
+    // около 3 * size (массив, reverse и обратный reverse). Побитовые циклы и std::bitset::to_string
+    // меряются на первых 64 МБ (скорость в ГБ/с от размера не зависит), перевод в текст - на четверти
+    // массива, но не больше 32 МБ: строка в 8 раз длиннее
+    std::size_t megabytes = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 32;
+    if (megabytes == 0) {
+        std::cerr << "usage: " << argv[0] << " [size in MB, > 0]" << std::endl;
+        return 1;
+    }
+    std::size_t size = megabytes << 20;
+    std::size_t slow_size = std::min<std::size_t>(size, 64 << 20);
+    std::size_t text_size = std::min<std::size_t>(size / 4, 32 << 20);
+
+    std::vector<std::uint64_t> words(size / 8);
+    std::uint64_t state = 88172645463325252ull;
+    for (std::uint64_t& word : words) {
+        state ^= state << 13;
+        state ^= state >> 7;
+        state ^= state << 17;
+        word = state;
+    }
+    const std::uint8_t* data = reinterpret_cast<const std::uint8_t*>(words.data());
+    std::cout << "implementation: " << bits::kBest.name << std::endl;
+
+    std::cout << "--- popcount" << std::endl;
+    Measure("shift loop", slow_size, [&] { return shifts::Popcount(data, slow_size); });
+    Measure("std::bitset<64>::count", size, [&] {
+        std::uint64_t count = 0;
+        for (std::uint64_t word : words) {
+            count += std::bitset<64>(word).count();
+        }
+        return count;
+    });
+    std::uint64_t portable_count = Measure("portable", size, [&] { return bits::portable::Popcount(data, size); });
+    std::uint64_t count = Measure(bits::kBest.name, size, [&] { return bits::Popcount(data, size); });
+
+    std::cout << "--- reverse" << std::endl;
+    std::vector<std::uint8_t> reversed(size);
+    std::vector<std::uint8_t> back(size);
+    Measure("shift loop", slow_size, [&] {
+        shifts::Reverse(data, slow_size, reversed.data());
+        return reversed[0];
+    });
+    Measure("portable", size, [&] {
+        bits::portable::Reverse(data, size, reversed.data());
+        return reversed[0];
+    });
+    Measure(bits::kBest.name, size, [&] {
+        bits::Reverse(data, size, reversed.data());
+        return reversed[0];
+    });
+    bits::Reverse(reversed.data(), size, back.data());
+    bool reverse_ok = std::memcmp(back.data(), data, size) == 0 && bits::Popcount(reversed.data(), size) == count;
+    std::vector<std::uint8_t>().swap(back);
+    std::vector<std::uint8_t>().swap(reversed);
+
+    std::cout << "--- binary to text" << std::endl;
+    std::string text(8 * text_size, ' ');
+    std::string expected(8 * text_size / 16, ' ');
+    Measure("std::bitset<8>::to_string", text_size / 16, [&] {
+        for (std::size_t i = 0; i < text_size / 16; i++) {
+            std::memcpy(&expected[8 * i], std::bitset<8>(data[i]).to_string().data(), 8);
+        }
+        return expected.size();
+    });
+    Measure("shift loop", text_size, [&] {
+        shifts::ToText(data, text_size, &text[0]);
+        return text.size();
+    });
+    Measure("portable", text_size, [&] {
+        bits::portable::ToText(data, text_size, &text[0]);
+        return text.size();
+    });
+    Measure(bits::kBest.name, text_size, [&] {
+        bits::ToText(data, text_size, &text[0]);
+        return text.size();
+    });
+    bool text_ok = text.compare(0, expected.size(), expected) == 0;
+
+    std::cout << "--- text to binary" << std::endl;
+    std::vector<std::uint8_t> parsed(text_size);
+    Measure("portable", text_size, [&] {
+        bits::portable::FromText(text.data(), text_size, parsed.data());
+        return parsed[0];
+    });
+    Measure(bits::kBest.name, text_size, [&] {
+        bits::FromText(text.data(), text_size, parsed.data());
+        return parsed[0];
+    });
+    text_ok = text_ok && std::memcmp(parsed.data(), data, text_size) == 0;
+    std::string().swap(text);
+
+    std::cout << "--- rank / select" << std::endl;
+    bits::RankSelect index(words.data(), words.size());
+    const std::size_t queries = 10000000;
+    std::vector<std::uint64_t> positions(queries);
+    for (std::uint64_t& pos : positions) {
+        state ^= state << 13;
+        state ^= state >> 7;
+        state ^= state << 17;
+        pos = state % (8 * size);
+    }
+    std::uint64_t rank_sum = MeasureQueries("rank", queries, [&] {
+        std::uint64_t sum = 0;
+        for (std::uint64_t pos : positions) {
+            sum += index.Rank(pos);
+        }
+        return sum;
+    });
+    MeasureQueries("select", queries, [&] {
+        std::uint64_t sum = 0;
+        for (std::uint64_t pos : positions) {
+            sum += index.Select(pos % index.Ones());
+        }
+        return sum;
+    });
+    bool rank_ok = index.Ones() == count && rank_sum != 0;
+    for (std::size_t i = 0; i < 1000 && rank_ok; i++) {
+        std::uint64_t k = positions[i] % index.Ones();
+        std::uint64_t pos = index.Select(k);
+        rank_ok = index.Rank(pos) == k && ((words[pos / 64] >> (pos % 64)) & 1);
+    }
+
+    std::cout << "popcount " << (portable_count == count ? "ok" : "mismatch") << ", reverse "
+              << (reverse_ok ? "ok" : "mismatch") << ", text " << (text_ok ? "ok" : "mismatch") << ", rank/select "
+              << (rank_ok ? "ok" : "mismatch") << std::endl;
+    return portable_count == count && reverse_ok && text_ok && rank_ok ? 0 : 1;
+}
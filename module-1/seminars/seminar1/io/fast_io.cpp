@@ -0,0 +1,530 @@
+#include <cerrno>
+#include <charconv>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include <fcntl.h>
+#include <unistd.h>
+
+// Быстрый ввод-вывод вместо std::cin >> number из io.cpp.
+// FastReader читает файловый дескриптор большими кусками через read(2) и сам
+// разбирает числа: целые - по 8 цифр за раз (SWAR: 8 символов в одном uint64_t),
+// double - точным быстрым путем для коротких записей, иначе через strtod,
+// строки цифр (например, для длинной арифметики) - целыми отрезками буфера.
+// FastWriter копит вывод в буфере и отдает его через write(2).
+
+namespace swar {
+    // символы лежат в uint64_t так, что первый - в младшем байте (little-endian)
+    std::uint64_t Load(const char* data) {
+        std::uint64_t chunk;
+        std::memcpy(&chunk, data, sizeof(chunk));
+        return chunk;
+    }
+
+    // по старшему биту в каждом байте, который не цифра: c - '0' > 9
+    std::uint64_t NonDigitMask(std::uint64_t chunk) {
+        std::uint64_t below = chunk - 0x3030303030303030ull;
+        std::uint64_t above = chunk + 0x4646464646464646ull;
+        return (below | above) & 0x8080808080808080ull;
+    }
+
+    // сколько цифр идет подряд с начала куска
+    unsigned LeadingDigits(std::uint64_t chunk) {
+        std::uint64_t mask = NonDigitMask(chunk);
+        return mask == 0 ? 8 : __builtin_ctzll(mask) / 8;
+    }
+
+    // "12345678" -> 12345678: соседние цифры склеиваются попарно, затем пары и четверки
+    std::uint32_t ParseEight(std::uint64_t chunk) {
+        chunk -= 0x3030303030303030ull;
+        chunk = (chunk * 10 + (chunk >> 8)) & 0x00FF00FF00FF00FFull;
+        chunk = (chunk * 100 + (chunk >> 16)) & 0x0000FFFF0000FFFFull;
+        chunk = (chunk * 10000 + (chunk >> 32)) & 0x00000000FFFFFFFFull;
+        return static_cast<std::uint32_t>(chunk);
+    }
+}
+
+class FastReader {
+public:
+    // буфер пуст и заполнен нулями: первое чтение - при первом разборе
+    explicit FastReader(int fd = 0) : fd_(fd), buffer_(kBuffer + kPadding) {}
+
+    FastReader(const FastReader&) = delete;
+    FastReader& operator=(const FastReader&) = delete;
+
+    // целое со знаком или без; переполнение не проверяется, как и у atoi
+    template<typename T>
+    bool ReadInteger(T& value) {
+        if (!SkipSpaces()) {
+            return false;
+        }
+        bool negative = buffer_[pos_] == '-';
+        if (buffer_[pos_] == '-' || buffer_[pos_] == '+') {
+            ++pos_;
+        }
+        std::uint64_t result = 0;
+        bool any = false;
+        while (true) {
+            // после конца данных в буфере нули, они не цифры: кусок из 8 цифр
+            // целиком лежит в данных, а короткий заканчивается не дальше end_
+            std::uint64_t chunk = swar::Load(&buffer_[pos_]);
+            unsigned digits = swar::LeadingDigits(chunk);
+            if (digits == 8) {
+                result = result * 100000000 + swar::ParseEight(chunk);
+                pos_ += 8;
+                any = true;
+                continue;
+            }
+            for (unsigned i = 0; i < digits; i++) {
+                result = result * 10 + (buffer_[pos_ + i] - '0');
+            }
+            pos_ += digits;
+            any = any || digits != 0;
+            // число могло оборваться на границе прочитанного - дочитываем
+            if (pos_ < end_ || !Refill()) {
+                break;
+            }
+        }
+        value = static_cast<T>(negative ? 0 - result : result);
+        return any;
+    }
+
+    // Быстрый путь: до 19 значащих цифр, мантисса до 2^53 и |показатель| <= 22 -
+    // тогда m * 10^e или m / 10^e это одно точное округление (как у strtod).
+    // Остальное (длинные мантиссы, inf, nan, hex) - через strtod
+    bool ReadDouble(double& value) {
+        if (!ReadToken(token_)) {
+            return false;
+        }
+        if (!ParseShortDouble(token_.c_str(), value)) {
+            char* end;
+            value = std::strtod(token_.c_str(), &end);
+            return *end == '\0';
+        }
+        return true;
+    }
+
+    // [+-]цифры: строка для конструктора длинного числа без разбора по символу
+    bool ReadDigits(std::string& digits) {
+        digits.clear();
+        if (!SkipSpaces()) {
+            return false;
+        }
+        if (buffer_[pos_] == '-' || buffer_[pos_] == '+') {
+            digits += buffer_[pos_++];
+        }
+        std::size_t sign = digits.size();
+        while (true) {
+            std::size_t run = pos_;
+            unsigned step;
+            do {
+                step = swar::LeadingDigits(swar::Load(&buffer_[run]));
+                run += step;
+            } while (step == 8);
+            digits.append(&buffer_[pos_], run - pos_);
+            pos_ = run;
+            if (pos_ < end_ || !Refill()) {
+                break;
+            }
+        }
+        return digits.size() > sign;
+    }
+
+    // очередное слово до пробельного символа
+    bool ReadToken(std::string& token) {
+        token.clear();
+        if (!SkipSpaces()) {
+            return false;
+        }
+        while (true) {
+            std::size_t run = pos_;
+            while (run < end_ && static_cast<unsigned char>(buffer_[run]) > ' ') {
+                ++run;
+            }
+            token.append(&buffer_[pos_], run - pos_);
+            pos_ = run;
+            if (pos_ < end_ || !Refill()) {
+                return true;
+            }
+        }
+    }
+
+private:
+    const static std::size_t kBuffer = 1 << 16;
+    const static std::size_t kPadding = 8;
+
+    // Вызывается, когда разбор дошел до end_. Один read(2): из файла он вернет
+    // целый буфер, а из терминала или канала - то, что уже есть, не дожидаясь
+    // заполнения буфера. false, если данных больше нет
+    bool Refill() {
+        if (eof_) {
+            return false;
+        }
+        std::memmove(buffer_.data(), &buffer_[pos_], end_ - pos_);
+        end_ -= pos_;
+        pos_ = 0;
+        ssize_t got;
+        do {
+            got = read(fd_, &buffer_[end_], kBuffer - end_);
+        } while (got < 0 && errno == EINTR);
+        if (got <= 0) {
+            eof_ = true;
+        } else {
+            end_ += got;
+        }
+        std::memset(&buffer_[end_], 0, kPadding);
+        return got > 0;
+    }
+
+    bool SkipSpaces() {
+        while (true) {
+            while (pos_ < end_ && static_cast<unsigned char>(buffer_[pos_]) <= ' ') {
+                ++pos_;
+            }
+            if (pos_ < end_) {
+                return true;
+            }
+            if (!Refill()) {
+                return false;
+            }
+        }
+    }
+
+    static bool ParseShortDouble(const char* str, double& value) {
+        static const double kPowers[] = {1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,  1e8,  1e9,  1e10, 1e11,
+                                         1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22};
+        bool negative = *str == '-';
+        if (*str == '-' || *str == '+') {
+            ++str;
+        }
+        std::uint64_t mantissa = 0;
+        int digits = 0;
+        int exponent = 0;
+        bool any = false;
+        for (; *str >= '0' && *str <= '9'; ++str, any = true) {
+            if (mantissa == 0 && *str == '0') {
+                continue;
+            }
+            mantissa = mantissa * 10 + (*str - '0');
+            ++digits;
+        }
+        if (*str == '.') {
+            for (++str; *str >= '0' && *str <= '9'; ++str, any = true) {
+                if (mantissa == 0 && *str == '0') {
+                    --exponent;
+                    continue;
+                }
+                mantissa = mantissa * 10 + (*str - '0');
+                ++digits;
+                --exponent;
+            }
+        }
+        if (!any || digits > 19) {
+            return false;
+        }
+        if (*str == 'e' || *str == 'E') {
+            ++str;
+            bool negative_exponent = *str == '-';
+            if (*str == '-' || *str == '+') {
+                ++str;
+            }
+            if (*str < '0' || *str > '9') {
+                return false;
+            }
+            int power = 0;
+            for (; *str >= '0' && *str <= '9' && power < 10000; ++str) {
+                power = power * 10 + (*str - '0');
+            }
+            exponent += negative_exponent ? -power : power;
+        }
+        if (*str != '\0' || mantissa > (std::uint64_t(1) << 53) || exponent < -22 || exponent > 22) {
+            return false;
+        }
+        double result = static_cast<double>(mantissa);
+        result = exponent < 0 ? result / kPowers[-exponent] : result * kPowers[exponent];
+        value = negative ? -result : result;
+        return true;
+    }
+
+    int fd_;
+    std::vector<char> buffer_;
+    std::size_t pos_ = 0;
+    std::size_t end_ = 0;
+    bool eof_ = false;
+    std::string token_;
+};
+
+template<typename T>
+typename std::enable_if<std::is_integral<T>::value, FastReader&>::type operator>>(FastReader& in, T& value) {
+    in.ReadInteger(value);
+    return in;
+}
+
+FastReader& operator>>(FastReader& in, double& value) {
+    in.ReadDouble(value);
+    return in;
+}
+
+FastReader& operator>>(FastReader& in, std::string& token) {
+    in.ReadToken(token);
+    return in;
+}
+
+class FastWriter {
+public:
+    explicit FastWriter(int fd = 1) : fd_(fd), buffer_(kBuffer) {}
+
+    FastWriter(const FastWriter&) = delete;
+    FastWriter& operator=(const FastWriter&) = delete;
+
+    ~FastWriter() {
+        Flush();
+    }
+
+    template<typename T>
+    typename std::enable_if<std::is_integral<T>::value>::type Write(T value) {
+        Reserve(24);
+        std::uint64_t rest = static_cast<std::uint64_t>(value);
+        if constexpr (std::is_signed<T>::value) {
+            if (value < 0) {
+                buffer_[size_++] = '-';
+                rest = 0 - rest;
+            }
+        }
+        // цифры пишем с конца по две из таблицы "00".."99"
+        char digits[20];
+        char* end = digits + sizeof(digits);
+        char* begin = end;
+        while (rest >= 100) {
+            begin -= 2;
+            std::memcpy(begin, &kPairs[2 * (rest % 100)], 2);
+            rest /= 100;
+        }
+        if (rest >= 10) {
+            begin -= 2;
+            std::memcpy(begin, &kPairs[2 * rest], 2);
+        } else {
+            *--begin = static_cast<char>('0' + rest);
+        }
+        std::memcpy(&buffer_[size_], begin, end - begin);
+        size_ += end - begin;
+    }
+
+    // кратчайшая запись, которая читается обратно в то же число
+    void Write(double value) {
+        Reserve(32);
+        size_ = std::to_chars(&buffer_[size_], &buffer_[size_] + 32, value).ptr - buffer_.data();
+    }
+
+    void Write(char c) {
+        Reserve(1);
+        buffer_[size_++] = c;
+    }
+
+    void Write(const std::string& str) {
+        if (str.size() > kBuffer) {
+            Flush();
+            WriteAll(str.data(), str.size());
+            return;
+        }
+        Reserve(str.size());
+        std::memcpy(&buffer_[size_], str.data(), str.size());
+        size_ += str.size();
+    }
+
+    void Flush() {
+        WriteAll(buffer_.data(), size_);
+        size_ = 0;
+    }
+
+private:
+    const static std::size_t kBuffer = 1 << 16;
+    static const char kPairs[201];
+
+    void Reserve(std::size_t count) {
+        if (size_ + count > kBuffer) {
+            Flush();
+        }
+    }
+
+    void WriteAll(const char* data, std::size_t count) {
+        while (count > 0) {
+            ssize_t written = write(fd_, data, count);
+            if (written <= 0) {
+                return;
+            }
+            data += written;
+            count -= written;
+        }
+    }
+
+    int fd_;
+    std::vector<char> buffer_;
+    std::size_t size_ = 0;
+};
+
+const char FastWriter::kPairs[201] =
+    "00010203040506070809101112131415161718192021222324252627282930313233343536373839"
+    "40414243444546474849505152535455565758596061626364656667686970717273747576777879"
+    "8081828384858687888990919293949596979899";
+
+template<typename T>
+FastWriter& operator<<(FastWriter& out, const T& value) {
+    out.Write(value);
+    return out;
+}
+
+FastWriter& operator<<(FastWriter& out, const char* str) {
+    while (*str) {
+        out.Write(*str++);
+    }
+    return out;
+}
+
+// -1, если файл не открылся: причина печатается по errno
+off_t FileSize(const char* path) {
+    int fd = open(path, O_RDONLY);
+    if (fd == -1) {
+        std::cerr << path << ": " << std::strerror(errno) << std::endl;
+        return -1;
+    }
+    off_t size = lseek(fd, 0, SEEK_END);
+    close(fd);
+    return size;
+}
+
+template<typename F>
+unsigned long long Measure(const char* name, std::size_t bytes, F f) {
+    auto start = std::chrono::steady_clock::now();
+    unsigned long long result = f();
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    std::cout << name << ": " << seconds * 1000 << " ms, " << bytes / seconds / (1 << 20) << " MB/s" << std::endl;
+    return result;
+}
+
+int main(int argc, char** argv) {
+    // как io.cpp, только через FastReader / FastWriter: fast_io < file
+    if (argc > 1 && std::string(argv[1]) == "echo") {
+        FastReader in(0);
+        FastWriter out(1);
+        long long number;
+        while (in.ReadInteger(number)) {
+            out << "Value : " << number << '\n';
+            out.Flush();
+        }
+        return 0;
+    }
+
+    // иначе - сравнение на временном файле из count чисел (по умолчанию 10^7)
+    std::size_t count = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 10000000;
+    const char* path = "fast_io_bench.txt";
+    {
+        int fd = open(path, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+        if (fd == -1) {
+            std::cerr << path << ": " << std::strerror(errno) << std::endl;
+            return 1;
+        }
+        FastWriter out(fd);
+        std::uint64_t state = 42;
+        for (std::size_t i = 0; i < count; i++) {
+            state = state * 6364136223846793005ull + 1442695040888963407ull;
+            out << static_cast<long long>(state >> 1) * (i % 2 == 0 ? 1 : -1) << '\n';
+        }
+        out.Flush();
+        close(fd);
+    }
+    off_t size = FileSize(path);
+    if (size < 0) {
+        return 1;
+    }
+    std::size_t bytes = size;
+
+    unsigned long long synced = Measure("std::cin >> (synced)", bytes, [&] {
+        std::freopen(path, "r", stdin);
+        unsigned long long sum = 0;
+        long long number;
+        while (std::cin >> number) {
+            sum += number;
+        }
+        std::cin.clear();
+        return sum;
+    });
+    unsigned long long scanf_sum = Measure("scanf", bytes, [&] {
+        std::freopen(path, "r", stdin);
+        unsigned long long sum = 0;
+        long long number;
+        while (std::scanf("%lld", &number) == 1) {
+            sum += number;
+        }
+        return sum;
+    });
+    // sync_with_stdio можно переключить только до ввода, поэтому этот замер последний из потоковых
+    unsigned long long unsynced = Measure("std::cin >> (sync_with_stdio(false))", bytes, [&] {
+        std::ios::sync_with_stdio(false);
+        std::freopen(path, "r", stdin);
+        unsigned long long sum = 0;
+        long long number;
+        while (std::cin >> number) {
+            sum += number;
+        }
+        std::cin.clear();
+        return sum;
+    });
+    unsigned long long fast = Measure("FastReader", bytes, [&] {
+        int fd = open(path, O_RDONLY);
+        FastReader in(fd);
+        unsigned long long sum = 0;
+        long long number;
+        while (in.ReadInteger(number)) {
+            sum += number;
+        }
+        close(fd);
+        return sum;
+    });
+    unsigned long long digits = Measure("FastReader::ReadDigits", bytes, [&] {
+        int fd = open(path, O_RDONLY);
+        FastReader in(fd);
+        long long length = 0;
+        std::string number;
+        while (in.ReadDigits(number)) {
+            length += number.size();
+        }
+        close(fd);
+        return length;
+    });
+    std::cout << "checksum: " << synced << " " << unsynced << " " << scanf_sum << " " << fast
+              << ", digits: " << digits << std::endl;
+
+    // double: запись и чтение обратно должны давать те же числа
+    {
+        int fd = open(path, O_WRONLY | O_TRUNC);
+        FastWriter out(fd);
+        for (std::size_t i = 0; i < count / 10; i++) {
+            out << (i * 0.001 - 17.25) << ' ' << 1.0 / (i + 1) << '\n';
+        }
+        out.Flush();
+        close(fd);
+    }
+    Measure("FastReader doubles", FileSize(path), [&] {
+        int fd = open(path, O_RDONLY);
+        FastReader in(fd);
+        long long mismatches = 0;
+        double first, second;
+        for (std::size_t i = 0; in.ReadDouble(first) && in.ReadDouble(second); i++) {
+            mismatches += first != i * 0.001 - 17.25 || second != 1.0 / (i + 1);
+        }
+        close(fd);
+        std::cout << "double mismatches: " << mismatches << std::endl;
+        return mismatches;
+    });
+    std::remove(path);
+    return 0;
+}
@@ -0,0 +1,335 @@
+#include <cassert>
+#include <chrono>
+#include <cstddef>
+#include <cstdlib>
+#include <iostream>
+#include <new>
+#include <string>
+#include <type_traits>
+#include <utility>
+
+// Adapter из local_classes.cpp на каждую адаптацию делает new LocalClass (и теряет его).
+// AnyInterface<InterfaceA> хранит адаптер по значению во внутреннем буфере
+// (small buffer optimization): для захваченных данных до 48 байт аллокаций нет,
+// а вызов MethodA у AnyInterface - один косвенный переход через "ручную" таблицу функций.
+// Через InterfaceA* (как в LegacyFunction) переходов два: виртуальный AnyInterface::MethodA,
+// затем method_a из таблицы SmallBox. Один переход был бы, если бы в буфере лежал наследник
+// InterfaceA и LegacyFunction получала указатель на него, но такой указатель портится при
+// перемещении AnyInterface; прямой вызов a.MethodA() компилятор девиртуализирует до одного.
+
+// в отличие от local_classes.cpp, деструкторы виртуальные: адаптеры здесь удаляются
+class InterfaceB {
+public:
+    virtual ~InterfaceB() {}
+    virtual void MethodB(std::string) { std::cout << "Hello world!" << std::endl;  };
+};
+
+class InterfaceA {
+public:
+    virtual ~InterfaceA() {}
+    virtual void MethodA() { std::cout << "Hello world!" << std::endl; }
+};
+
+void LegacyFunction(InterfaceA* obj) {
+    obj->MethodA();
+}
+
+// SmallBox: владеет объектом произвольного типа; если он помещается в буфер
+// и перемещается без исключений - лежит внутри, иначе - в куче
+template<typename VTable, std::size_t Size = 48>
+class SmallBox {
+public:
+    template<typename Impl>
+    struct Fits {
+        const static bool value = sizeof(Impl) <= Size && alignof(Impl) <= alignof(std::max_align_t)
+                                  && std::is_nothrow_move_constructible<Impl>::value;
+    };
+
+    SmallBox() = default;
+    SmallBox(const SmallBox&) = delete;
+    SmallBox& operator=(const SmallBox&) = delete;
+
+    SmallBox(SmallBox&& other) noexcept : vtable_(other.vtable_) {
+        if (vtable_) {
+            vtable_->move(&storage_, &other.storage_);
+            other.vtable_ = nullptr;
+        }
+    }
+
+    SmallBox& operator=(SmallBox&& other) noexcept {
+        if (this != &other) {
+            Reset();
+            vtable_ = other.vtable_;
+            if (vtable_) {
+                vtable_->move(&storage_, &other.storage_);
+                other.vtable_ = nullptr;
+            }
+        }
+        return *this;
+    }
+
+    ~SmallBox() {
+        Reset();
+    }
+
+    template<typename Impl>
+    void Emplace(Impl&& impl, const VTable* vtable) {
+        typedef typename std::decay<Impl>::type Stored;
+        Reset();
+        if constexpr (Fits<Stored>::value) {
+            new (&storage_) Stored(std::forward<Impl>(impl));
+        } else {
+            *reinterpret_cast<Stored**>(&storage_) = new Stored(std::forward<Impl>(impl));
+        }
+        vtable_ = vtable;
+    }
+
+    // адрес объекта: в буфере или по указателю из буфера
+    template<typename Impl>
+    static Impl* Get(void* storage) {
+        if constexpr (Fits<Impl>::value) {
+            return static_cast<Impl*>(storage);
+        }
+        return *static_cast<Impl**>(storage);
+    }
+
+    // move и destroy для таблицы функций конкретного Impl
+    template<typename Impl>
+    static void Move(void* dst, void* src) noexcept {
+        if constexpr (Fits<Impl>::value) {
+            new (dst) Impl(std::move(*Get<Impl>(src)));
+            Get<Impl>(src)->~Impl();
+        } else {
+            *static_cast<Impl**>(dst) = *static_cast<Impl**>(src);
+        }
+    }
+
+    template<typename Impl>
+    static void Destroy(void* storage) noexcept {
+        if constexpr (Fits<Impl>::value) {
+            Get<Impl>(storage)->~Impl();
+        } else {
+            delete Get<Impl>(storage);
+        }
+    }
+
+    const VTable* vtable() const {
+        return vtable_;
+    }
+
+    void* storage() {
+        return &storage_;
+    }
+
+private:
+    void Reset() {
+        if (vtable_) {
+            vtable_->destroy(&storage_);
+            vtable_ = nullptr;
+        }
+    }
+
+    typename std::aligned_storage<Size, alignof(std::max_align_t)>::type storage_;
+    const VTable* vtable_ = nullptr;
+};
+
+template<typename Interface>
+class AnyInterface;
+
+// AnyInterface<InterfaceA>: любой тип с методом void MethodA().
+// Сам является InterfaceA, поэтому годится для LegacyFunction
+template<>
+class AnyInterface<InterfaceA> final : public InterfaceA {
+private:
+    struct VTable {
+        void (*method_a)(void*);
+        void (*move)(void*, void*);
+        void (*destroy)(void*);
+    };
+
+    typedef SmallBox<VTable> Box;
+
+    template<typename Impl>
+    static void CallMethodA(void* storage) {
+        Box::template Get<Impl>(storage)->MethodA();
+    }
+
+    template<typename Impl>
+    struct VTableFor {
+        constexpr static VTable value = {&CallMethodA<Impl>, &Box::template Move<Impl>, &Box::template Destroy<Impl>};
+    };
+
+public:
+    template<typename Impl,
+             typename = typename std::enable_if<!std::is_same<typename std::decay<Impl>::type, AnyInterface>::value>::type>
+    AnyInterface(Impl&& impl) {
+        typedef typename std::decay<Impl>::type Stored;
+        box_.Emplace(std::forward<Impl>(impl), &VTableFor<Stored>::value);
+    }
+
+    AnyInterface(AnyInterface&&) = default;
+    AnyInterface& operator=(AnyInterface&&) = default;
+
+    // после перемещения объект пуст: вызывать MethodA у него нельзя
+    void MethodA() override {
+        assert(box_.vtable() && "MethodA on a moved-from AnyInterface");
+        box_.vtable()->method_a(box_.storage());
+    }
+
+private:
+    Box box_;
+};
+
+// адаптер без наследования и без new: локальный класс лишь реализует MethodA
+template<typename ObjType, typename ArgType>
+AnyInterface<InterfaceA> Adapter(const ObjType& obj, const ArgType& arg) {
+    class LocalClass {
+        public:
+            LocalClass(const ObjType& obj, const ArgType& arg) :
+                obj_(obj),
+                arg_(arg)
+            {}
+
+            void MethodA() {
+                obj_.MethodB(arg_);
+            }
+
+        private:
+            ObjType obj_;
+            ArgType arg_;
+    };
+
+    return AnyInterface<InterfaceA>(LocalClass(obj, arg));
+}
+
+// прежний вариант для сравнения
+template<typename ObjType, typename ArgType>
+InterfaceA* HeapAdapter(const ObjType& obj, const ArgType& arg) {
+    class LocalClass : public InterfaceA {
+        public:
+            LocalClass(const ObjType& obj, const ArgType& arg) :
+                obj_(obj),
+                arg_(arg)
+            {}
+
+            void MethodA() override {
+                obj_.MethodB(arg_);
+            }
+
+        private:
+            ObjType obj_;
+            ArgType arg_;
+    };
+
+    return new LocalClass(obj, arg);
+}
+
+// считаем вызовы вместо печати, чтобы мерить адаптацию, а не вывод
+static std::size_t calls = 0;
+
+class CountingB {
+public:
+    void MethodB(const std::string& s) { calls += s.size(); }
+};
+
+// Счетчик аллокаций: заменены все обычные и выровненные формы new / delete, иначе
+// память от незамененной формы освобождалась бы чужим delete (-Wmismatched-new-delete).
+// nothrow-формы по стандарту вызывают эти же
+static std::size_t allocations = 0;
+
+static void* Allocate(std::size_t size, std::size_t alignment) {
+    ++allocations;
+    size = size == 0 ? 1 : size;
+    // aligned_alloc требует размер, кратный выравниванию
+    void* ptr = alignment <= alignof(std::max_align_t)
+                    ? std::malloc(size)
+                    : std::aligned_alloc(alignment, (size + alignment - 1) / alignment * alignment);
+    if (ptr == nullptr) {
+        throw std::bad_alloc();
+    }
+    return ptr;
+}
+
+void* operator new(std::size_t size) {
+    return Allocate(size, alignof(std::max_align_t));
+}
+
+void* operator new[](std::size_t size) {
+    return Allocate(size, alignof(std::max_align_t));
+}
+
+void* operator new(std::size_t size, std::align_val_t alignment) {
+    return Allocate(size, static_cast<std::size_t>(alignment));
+}
+
+void* operator new[](std::size_t size, std::align_val_t alignment) {
+    return Allocate(size, static_cast<std::size_t>(alignment));
+}
+
+void operator delete(void* ptr) noexcept {
+    std::free(ptr);
+}
+
+void operator delete[](void* ptr) noexcept {
+    std::free(ptr);
+}
+
+void operator delete(void* ptr, std::size_t) noexcept {
+    std::free(ptr);
+}
+
+void operator delete[](void* ptr, std::size_t) noexcept {
+    std::free(ptr);
+}
+
+void operator delete(void* ptr, std::align_val_t) noexcept {
+    std::free(ptr);
+}
+
+void operator delete[](void* ptr, std::align_val_t) noexcept {
+    std::free(ptr);
+}
+
+void operator delete(void* ptr, std::size_t, std::align_val_t) noexcept {
+    std::free(ptr);
+}
+
+void operator delete[](void* ptr, std::size_t, std::align_val_t) noexcept {
+    std::free(ptr);
+}
+
+template<typename F>
+void Measure(const char* name, std::size_t count, F f) {
+    std::size_t allocations_before = allocations;
+    auto start = std::chrono::steady_clock::now();
+    for (std::size_t i = 0; i < count; i++) {
+        f();
+    }
+    auto finish = std::chrono::steady_clock::now();
+    std::cout << name << ": " << std::chrono::duration<double, std::nano>(finish - start).count() / count
+              << " ns, " << double(allocations - allocations_before) / count << " allocations per adaptation"
+              << std::endl;
+}
+
+int main() {
+    InterfaceB b;
+    AnyInterface<InterfaceA> a = Adapter(b, std::string("aaa"));
+    LegacyFunction(&a);
+
+    const std::size_t count = 10000000;
+    CountingB counting;
+    // 15 символов - строка еще в своем SSO-буфере, аллокации считаем только адаптера
+    std::string arg = "short argument!";
+
+    Measure("new LocalClass + call + delete", count, [&] {
+        InterfaceA* adapted = HeapAdapter(counting, arg);
+        adapted->MethodA();
+        delete adapted;
+    });
+    Measure("AnyInterface + call", count, [&] {
+        AnyInterface<InterfaceA> adapted = Adapter(counting, arg);
+        adapted.MethodA();
+    });
+    std::cout << "calls: " << calls << std::endl;
+    return 0;
+}
@@ -0,0 +1,228 @@
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+#include <random>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+// SoAVector<TList>: "структура массивов" по списку типов полей.
+// Каждому полю (по индексу, типы могут повторяться) - свой непрерывный столбец,
+// поэтому проход по одному полю читает только его байты и векторизуется.
+
+struct NullType {};
+
+template<typename Head, typename Tail>
+struct TypeList {
+    typedef Head H;
+    typedef Tail T;
+};
+
+template<typename TList>
+struct Length;
+
+template<>
+struct Length<NullType> {
+    const static std::size_t length = 0;
+};
+
+template<typename Head, typename Tail>
+struct Length<TypeList<Head, Tail>> {
+    const static std::size_t length = Length<Tail>::length + 1;
+};
+
+template<typename TList, std::size_t index>
+struct TypeAt;
+
+template<typename Head, typename Tail>
+struct TypeAt<TypeList<Head, Tail>, 0> {
+    typedef Head TargetType;
+};
+
+template<typename Head, typename Tail, std::size_t index>
+struct TypeAt<TypeList<Head, Tail>, index> {
+    typedef typename TypeAt<Tail, index - 1>::TargetType TargetType;
+};
+
+// Вид на столбец: элементы можно читать и менять, но не добавлять и не удалять,
+// иначе столбцы разойдутся по длине
+template<typename T>
+class ColumnView {
+public:
+    ColumnView(T* data, std::size_t size) : data_(data), size_(size) {}
+
+    T* begin() const {
+        return data_;
+    }
+
+    T* end() const {
+        return data_ + size_;
+    }
+
+    T* data() const {
+        return data_;
+    }
+
+    std::size_t size() const {
+        return size_;
+    }
+
+    T& operator[](std::size_t pos) const {
+        return data_[pos];
+    }
+
+private:
+    T* data_;
+    std::size_t size_;
+};
+
+// столбец поля index
+template<typename TList, std::size_t index>
+struct Column {
+    std::vector<typename TypeAt<TList, index>::TargetType> data;
+};
+
+template<typename TList, typename Indices = std::make_index_sequence<Length<TList>::length>>
+class SoAVector;
+
+template<typename TList, std::size_t... Is>
+class SoAVector<TList, std::index_sequence<Is...>> : private Column<TList, Is>... {
+public:
+    template<std::size_t index>
+    using FieldType = typename TypeAt<TList, index>::TargetType;
+
+    typedef std::tuple<FieldType<Is>...> Row;
+
+    std::size_t size() const {
+        return size_;
+    }
+
+    void reserve(std::size_t count) {
+        (Column<TList, Is>::data.reserve(count), ...);
+    }
+
+    // если push_back какого-то столбца бросит, уже дополненные столбцы откатываются
+    void push_back(const Row& row) {
+        std::size_t pushed = 0;
+        try {
+            ((Column<TList, Is>::data.push_back(std::get<Is>(row)), ++pushed), ...);
+        } catch (...) {
+            ((Is < pushed ? Column<TList, Is>::data.pop_back() : void()), ...);
+            throw;
+        }
+        ++size_;
+    }
+
+    Row row(std::size_t pos) const {
+        return Row(get<Is>(pos)...);
+    }
+
+    template<std::size_t index>
+    FieldType<index>& get(std::size_t pos) {
+        return Column<TList, index>::data[pos];
+    }
+
+    template<std::size_t index>
+    const FieldType<index>& get(std::size_t pos) const {
+        return Column<TList, index>::data[pos];
+    }
+
+    template<std::size_t index>
+    ColumnView<FieldType<index>> column() {
+        return {Column<TList, index>::data.data(), size_};
+    }
+
+    template<std::size_t index>
+    ColumnView<const FieldType<index>> column() const {
+        return {Column<TList, index>::data.data(), size_};
+    }
+
+private:
+    std::size_t size_ = 0;
+};
+
+// запись биржевой сделки: поля описаны списком типов ...
+typedef TypeList<std::int64_t, TypeList<double, TypeList<double, TypeList<std::int32_t, TypeList<char, NullType>>>>> TradeFields;
+
+enum { kId, kPrice, kVolume, kVenue, kSide };
+
+// ... и той же структурой для сравнения
+struct Trade {
+    std::int64_t id;
+    double price;
+    double volume;
+    std::int32_t venue;
+    char side;
+};
+
+template<typename F>
+double Measure(const char* name, F f) {
+    const int passes = 10;
+    double result = f();
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < passes; i++) {
+        result += f();
+    }
+    auto finish = std::chrono::steady_clock::now();
+    std::cout << name << ": "
+              << std::chrono::duration<double, std::milli>(finish - start).count() / passes << " ms" << std::endl;
+    return result;
+}
+
+int main() {
+    const std::size_t count = 10000000;
+    std::mt19937 gen(42);
+    std::uniform_real_distribution<double> price(10, 100);
+
+    SoAVector<TradeFields> soa;
+    std::vector<Trade> aos;
+    soa.reserve(count);
+    aos.reserve(count);
+    for (std::size_t i = 0; i < count; i++) {
+        Trade trade = {static_cast<std::int64_t>(i), price(gen), price(gen), static_cast<std::int32_t>(i % 7),
+                       i % 2 ? 'b' : 's'};
+        aos.push_back(trade);
+        soa.push_back(SoAVector<TradeFields>::Row(trade.id, trade.price, trade.volume, trade.venue, trade.side));
+    }
+
+    // скан одного столбца: структура тащит в кэш все 32 байта записи.
+    // Сумму double компилятор векторизует только с -ffast-math (перестановка сложений),
+    // целочисленные столбцы - и без нее
+    double aos_sum = Measure("vector<struct>: sum price", [&] {
+        double sum = 0;
+        for (const Trade& trade : aos) {
+            sum += trade.price;
+        }
+        return sum;
+    });
+    double soa_sum = Measure("SoAVector:      sum price", [&] {
+        double sum = 0;
+        for (double p : soa.column<kPrice>()) {
+            sum += p;
+        }
+        return sum;
+    });
+
+    // скан двух столбцов: оборот
+    double aos_turnover = Measure("vector<struct>: price * volume", [&] {
+        double sum = 0;
+        for (const Trade& trade : aos) {
+            sum += trade.price * trade.volume;
+        }
+        return sum;
+    });
+    double soa_turnover = Measure("SoAVector:      price * volume", [&] {
+        ColumnView<const double> prices = std::as_const(soa).column<kPrice>();
+        ColumnView<const double> volumes = std::as_const(soa).column<kVolume>();
+        double sum = 0;
+        for (std::size_t i = 0; i < prices.size(); i++) {
+            sum += prices[i] * volumes[i];
+        }
+        return sum;
+    });
+
+    std::cout << "checksum: " << aos_sum - soa_sum << " " << aos_turnover - soa_turnover << std::endl;
+    std::cout << "row 3: id " << std::get<kId>(soa.row(3)) << " side " << soa.get<kSide>(3) << std::endl;
+    return 0;
+}
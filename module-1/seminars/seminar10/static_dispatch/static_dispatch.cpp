@@ -0,0 +1,329 @@
+#include <chrono>
+#include <cstddef>
+#include <iostream>
+#include <random>
+#include <utility>
+#include <variant>
+#include <vector>
+
+// Диспетчеризация по TypeList без виртуальных вызовов:
+// тип объекта - это его индекс в списке (IndexOf), а вызов идет через
+// constexpr-таблицу указателей на функции, построенную по TypeAt.
+// Плюс генераторы иерархий GenScatterHierarchy / GenLinearHierarchy
+// из Modern C++ Design, глава 3.
+
+struct NullType {};
+
+template<typename Head, typename Tail>
+struct TypeList {
+    typedef Head H;
+    typedef Tail T;
+};
+
+template<typename TList>
+struct Length;
+
+template<>
+struct Length<NullType> {
+    const static std::size_t length = 0;
+};
+
+template<typename Head, typename Tail>
+struct Length<TypeList<Head, Tail>> {
+    const static std::size_t length = Length<Tail>::length + 1;
+};
+
+template<typename TList, std::size_t index>
+struct TypeAt;
+
+template<typename Head, typename Tail>
+struct TypeAt<TypeList<Head, Tail>, 0> {
+    typedef Head TargetType;
+};
+
+template<typename Head, typename Tail, std::size_t index>
+struct TypeAt<TypeList<Head, Tail>, index> {
+    typedef typename TypeAt<Tail, index - 1>::TargetType TargetType;
+};
+
+template<typename TList, typename TargetType>
+struct IndexOf;
+
+template<typename TargetType>
+struct IndexOf<NullType, TargetType> {
+    const static int pos = -1;
+};
+
+template<typename Tail, typename TargetType>
+struct IndexOf<TypeList<TargetType, Tail>, TargetType> {
+    const static int pos = 0;
+};
+
+template<typename Head, typename Tail, typename TargetType>
+struct IndexOf<TypeList<Head, Tail>, TargetType> {
+private:
+    const static int actual = IndexOf<Tail, TargetType>::pos;
+public:
+    const static int pos = (actual == -1) ? -1 : actual + 1;
+};
+
+// GenScatterHierarchy: класс, унаследованный от Unit<T> для каждого T из списка
+template<typename TList, template<typename> class Unit>
+class GenScatterHierarchy;
+
+template<typename Head, typename Tail, template<typename> class Unit>
+class GenScatterHierarchy<TypeList<Head, Tail>, Unit>
+    : public Unit<Head>, public GenScatterHierarchy<Tail, Unit> {};
+
+template<template<typename> class Unit>
+class GenScatterHierarchy<NullType, Unit> {};
+
+// доступ к "полю" нужного типа - приведение к базе Unit<T>
+template<typename T, typename TList, template<typename> class Unit>
+Unit<T>& Field(GenScatterHierarchy<TList, Unit>& obj) {
+    return obj;
+}
+
+// GenLinearHierarchy: цепочка Unit<T1, Unit<T2, ... Root>> без множественного наследования
+template<typename TList, template<typename, typename> class Unit, typename Root = NullType>
+class GenLinearHierarchy;
+
+template<typename Head, typename Tail, template<typename, typename> class Unit, typename Root>
+class GenLinearHierarchy<TypeList<Head, Tail>, Unit, Root>
+    : public Unit<Head, GenLinearHierarchy<Tail, Unit, Root>> {};
+
+template<template<typename, typename> class Unit, typename Root>
+class GenLinearHierarchy<NullType, Unit, Root> : public Root {};
+
+// тип результата visitor - тот, что он возвращает для первого типа списка;
+// для остальных типов результат к нему приводится
+template<typename TList, typename Visitor>
+struct VisitResult {
+    typedef decltype(std::declval<Visitor&>()(std::declval<const typename TList::H&>())) type;
+};
+
+// DispatchTable: table[i] вызывает visitor от объекта типа TypeAt<TList, i>
+template<typename T, typename Visitor, typename Result>
+struct Thunk {
+    static Result Call(const void* obj, Visitor& visitor) {
+        return visitor(*static_cast<const T*>(obj));
+    }
+};
+
+template<typename TList, typename Visitor, typename Indices = std::make_index_sequence<Length<TList>::length>>
+struct DispatchTable;
+
+template<typename TList, typename Visitor, std::size_t... Is>
+struct DispatchTable<TList, Visitor, std::index_sequence<Is...>> {
+    typedef typename VisitResult<TList, Visitor>::type Result;
+    typedef Result (*Function)(const void*, Visitor&);
+    constexpr static Function table[] = {&Thunk<typename TypeAt<TList, Is>::TargetType, Visitor, Result>::Call...};
+};
+
+// объект "по ссылке": индекс типа в списке и адрес
+struct Handle {
+    int tag;
+    const void* obj;
+};
+
+template<typename TList, typename T>
+Handle MakeHandle(const T& obj) {
+    static_assert(IndexOf<TList, T>::pos >= 0, "type is not in the list");
+    return {IndexOf<TList, T>::pos, &obj};
+}
+
+template<typename TList, typename Visitor>
+typename VisitResult<TList, Visitor>::type Dispatch(Handle handle, Visitor& visitor) {
+    return DispatchTable<TList, Visitor>::table[handle.tag](handle.obj, visitor);
+}
+
+// фигуры для сравнения: без виртуальных функций ...
+struct Circle {
+    double r;
+};
+
+struct Square {
+    double side;
+};
+
+struct Rect {
+    double w;
+    double h;
+};
+
+typedef TypeList<Circle, TypeList<Square, TypeList<Rect, NullType>>> Shapes;
+
+struct Area {
+    double operator()(const Circle& c) const { return 3.1415926 * c.r * c.r; }
+    double operator()(const Square& s) const { return s.side * s.side; }
+    double operator()(const Rect& r) const { return r.w * r.h; }
+};
+
+struct Name {
+    const char* operator()(const Circle&) const { return "circle"; }
+    const char* operator()(const Square&) const { return "square"; }
+    const char* operator()(const Rect&) const { return "rect"; }
+};
+
+// ... и те же фигуры с виртуальным area()
+struct Shape {
+    virtual ~Shape() {}
+    virtual double area() const = 0;
+};
+
+struct VirtualCircle : Shape {
+    explicit VirtualCircle(Circle c) : c_(c) {}
+    double area() const override { return Area()(c_); }
+    Circle c_;
+};
+
+struct VirtualSquare : Shape {
+    explicit VirtualSquare(Square s) : s_(s) {}
+    double area() const override { return Area()(s_); }
+    Square s_;
+};
+
+struct VirtualRect : Shape {
+    explicit VirtualRect(Rect r) : r_(r) {}
+    double area() const override { return Area()(r_); }
+    Rect r_;
+};
+
+// хранилище: по std::vector на каждый тип из списка
+template<typename T>
+struct Holder {
+    std::vector<T> items;
+};
+
+template<typename T>
+struct Type2Type {
+    typedef T value_type;
+};
+
+// GenLinearHierarchy: перегрузки Visit / Count для каждого типа в одной цепочке
+template<typename T, typename Base>
+struct Counter : Base {
+    using Base::Visit;
+    using Base::Count;
+
+    void Visit(const T&) { ++count_; }
+    std::size_t Count(Type2Type<T>) const { return count_; }
+
+private:
+    std::size_t count_ = 0;
+};
+
+struct CounterRoot {
+    void Visit() {}
+    void Count() const {}
+};
+
+template<typename F>
+double Measure(const char* name, std::size_t count, F f) {
+    const int passes = 20;
+    double result = f();
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < passes; i++) {
+        result += f();
+    }
+    auto finish = std::chrono::steady_clock::now();
+    double ns = std::chrono::duration<double, std::nano>(finish - start).count() / passes / count;
+    std::cout << name << ": " << ns << " ns/shape" << std::endl;
+    return result;
+}
+
+int main() {
+    const std::size_t count = 1000000;
+    std::mt19937 gen(42);
+    std::uniform_int_distribution<int> kind(0, 2);
+    std::uniform_real_distribution<double> size(1, 10);
+
+    GenScatterHierarchy<Shapes, Holder> storage;
+    std::vector<int> kinds(count);
+    for (int& k : kinds) {
+        k = kind(gen);
+        switch (k) {
+            case 0: Field<Circle>(storage).items.push_back({size(gen)}); break;
+            case 1: Field<Square>(storage).items.push_back({size(gen)}); break;
+            case 2: Field<Rect>(storage).items.push_back({size(gen), size(gen)}); break;
+        }
+    }
+
+    // один и тот же набор фигур в трех представлениях, в одном порядке.
+    // Виртуальные объекты, как и хранилище для Handle, лежат подряд в векторе своего типа
+    // (reserve заранее, чтобы указатели не портились), так что замер сравнивает только
+    // способ вызова, а не раскладку в памяти
+    std::vector<Handle> handles;
+    std::vector<VirtualCircle> virtual_circles;
+    std::vector<VirtualSquare> virtual_squares;
+    std::vector<VirtualRect> virtual_rects;
+    virtual_circles.reserve(Field<Circle>(storage).items.size());
+    virtual_squares.reserve(Field<Square>(storage).items.size());
+    virtual_rects.reserve(Field<Rect>(storage).items.size());
+    std::vector<Shape*> virtuals;
+    std::vector<std::variant<Circle, Square, Rect>> variants;
+    std::size_t next[3] = {0, 0, 0};
+    for (int k : kinds) {
+        std::size_t i = next[k]++;
+        switch (k) {
+            case 0: {
+                const Circle& c = Field<Circle>(storage).items[i];
+                handles.push_back(MakeHandle<Shapes>(c));
+                virtuals.push_back(&virtual_circles.emplace_back(c));
+                variants.emplace_back(c);
+                break;
+            }
+            case 1: {
+                const Square& s = Field<Square>(storage).items[i];
+                handles.push_back(MakeHandle<Shapes>(s));
+                virtuals.push_back(&virtual_squares.emplace_back(s));
+                variants.emplace_back(s);
+                break;
+            }
+            case 2: {
+                const Rect& r = Field<Rect>(storage).items[i];
+                handles.push_back(MakeHandle<Shapes>(r));
+                virtuals.push_back(&virtual_rects.emplace_back(r));
+                variants.emplace_back(r);
+                break;
+            }
+        }
+    }
+
+    GenLinearHierarchy<Shapes, Counter, CounterRoot> counter;
+    for (const auto& v : variants) {
+        std::visit([&counter](const auto& shape) { counter.Visit(shape); }, v);
+    }
+    std::cout << "circles: " << counter.Count(Type2Type<Circle>())
+              << " squares: " << counter.Count(Type2Type<Square>())
+              << " rects: " << counter.Count(Type2Type<Rect>()) << std::endl;
+
+    Name name;
+    std::cout << "first shape: " << Dispatch<Shapes>(handles[0], name) << std::endl;
+
+    Area area;
+    double table = Measure("dispatch table", count, [&] {
+        double sum = 0;
+        for (Handle h : handles) {
+            sum += Dispatch<Shapes>(h, area);
+        }
+        return sum;
+    });
+    double virt = Measure("virtual call", count, [&] {
+        double sum = 0;
+        for (const Shape* shape : virtuals) {
+            sum += shape->area();
+        }
+        return sum;
+    });
+    double visit = Measure("std::visit", count, [&] {
+        double sum = 0;
+        for (const auto& v : variants) {
+            sum += std::visit(area, v);
+        }
+        return sum;
+    });
+
+    std::cout << "checksum: " << table << " " << virt << " " << visit << std::endl;
+    return 0;
+}
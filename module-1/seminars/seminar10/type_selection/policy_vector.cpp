@@ -0,0 +1,353 @@
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <iostream>
+#include <memory>
+#include <new>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+// PolicyVector<T>: контейнер, который на этапе компиляции выбирает способ хранения
+// (как NinftyContainer из generic.cpp и Container из seminar9/int2type):
+// * тривиально копируемые T - лежат в буфере, копирование и перенос - memcpy
+// * прочие неполиморфные T - лежат в буфере, копируются поэлементно
+// * полиморфные T - хранятся указатели на клоны, а сами клоны - в арене,
+//   то есть без отдельного new на каждый элемент
+
+template<bool isPolymorphic, typename T, typename U>
+struct Select {
+    typedef T type;
+};
+
+template<typename T, typename U>
+struct Select<false, T, U> {
+    typedef U type;
+};
+
+template<int v>
+struct Int2Type {
+    enum { value = v };
+};
+
+// Арена: выделяет память кусками и освобождает все разом.
+// Полиморфный T клонирует себя в арену: virtual T* Clone(Arena&) const
+class Arena {
+public:
+    Arena() = default;
+    Arena(const Arena&) = delete;
+    Arena& operator=(const Arena&) = delete;
+
+    void* Allocate(std::size_t size, std::size_t align) {
+        std::size_t offset = (used_ + align - 1) / align * align;
+        if (blocks_.empty() || offset + size > block_size_) {
+            block_size_ = std::max(2 * block_size_, size + align);
+            blocks_.emplace_back(new char[block_size_]);
+            std::size_t shift = reinterpret_cast<std::uintptr_t>(blocks_.back().get()) % align;
+            offset = shift == 0 ? 0 : align - shift;
+        }
+        used_ = offset + size;
+        return blocks_.back().get() + offset;
+    }
+
+    void swap(Arena& other) {
+        blocks_.swap(other.blocks_);
+        std::swap(block_size_, other.block_size_);
+        std::swap(used_, other.used_);
+    }
+
+private:
+    std::vector<std::unique_ptr<char[]>> blocks_;
+    std::size_t block_size_ = 2048;
+    std::size_t used_ = 0;
+};
+
+enum { kTrivial, kValue, kPolymorphic };
+
+template<typename T>
+struct StoragePolicy {
+    const static int value = std::is_polymorphic<T>::value ? kPolymorphic
+                             : std::is_trivially_copyable<T>::value ? kTrivial : kValue;
+};
+
+template<typename T>
+class PolicyVector {
+private:
+    const static int kPolicy = StoragePolicy<T>::value;
+    const static bool isPolymorphic = kPolicy == kPolymorphic;
+
+    // в буфере лежат либо сами T, либо указатели на клоны
+    typedef typename Select<isPolymorphic, T*, T>::type StoredType;
+
+    // клоны разрушаются через указатель на T
+    static_assert(!isPolymorphic || std::has_virtual_destructor<T>::value,
+                  "polymorphic T needs a virtual destructor");
+
+public:
+    PolicyVector() = default;
+
+    // деструктор недостроенного объекта не вызовется, поэтому буфер освобождаем сами;
+    // уже построенные элементы разрушает CopyFrom
+    PolicyVector(const PolicyVector& other) {
+        Reserve(other.size_);
+        try {
+            CopyFrom(other, Int2Type<kPolicy>());
+        } catch (...) {
+            ::operator delete(data_);
+            throw;
+        }
+        size_ = other.size_;
+    }
+
+    PolicyVector(PolicyVector&& other) noexcept {
+        swap(other);
+    }
+
+    PolicyVector& operator=(PolicyVector other) {
+        swap(other);
+        return *this;
+    }
+
+    ~PolicyVector() {
+        Destroy(data_, 0, size_, Int2Type<kPolicy>());
+        ::operator delete(data_);
+    }
+
+    std::size_t size() const {
+        return size_;
+    }
+
+    T& operator[](std::size_t pos) {
+        return Get(pos, Int2Type<isPolymorphic>());
+    }
+
+    const T& operator[](std::size_t pos) const {
+        return const_cast<PolicyVector&>(*this).Get(pos, Int2Type<isPolymorphic>());
+    }
+
+    // value может лежать в этом же векторе, поэтому при росте новый элемент
+    // строится в новом буфере до того, как старые переносятся и буфер освобождается
+    void push_back(const T& value) {
+        if (size_ < capacity_) {
+            Construct(data_ + size_, value, Int2Type<isPolymorphic>());
+        } else {
+            std::size_t capacity = capacity_ == 0 ? 8 : 2 * capacity_;
+            StoredType* data = static_cast<StoredType*>(::operator new(capacity * sizeof(StoredType)));
+            try {
+                Construct(data + size_, value, Int2Type<isPolymorphic>());
+            } catch (...) {
+                ::operator delete(data);
+                throw;
+            }
+            try {
+                Reallocate(data, capacity);
+            } catch (...) {
+                Destroy(data, size_, size_ + 1, Int2Type<kPolicy>());
+                ::operator delete(data);
+                throw;
+            }
+        }
+        ++size_;
+    }
+
+    void Reserve(std::size_t capacity) {
+        if (capacity > capacity_) {
+            StoredType* data = static_cast<StoredType*>(::operator new(capacity * sizeof(StoredType)));
+            try {
+                Reallocate(data, capacity);
+            } catch (...) {
+                ::operator delete(data);
+                throw;
+            }
+        }
+    }
+
+    void swap(PolicyVector& other) {
+        std::swap(data_, other.data_);
+        std::swap(size_, other.size_);
+        std::swap(capacity_, other.capacity_);
+        arena_.swap(other.arena_);
+    }
+
+private:
+    // если перенос бросит, старый буфер не тронут, а новый освобождает вызывающий
+    void Reallocate(StoredType* data, std::size_t capacity) {
+        Relocate(data, Int2Type<kPolicy == kValue>());
+        ::operator delete(data_);
+        data_ = data;
+        capacity_ = capacity;
+    }
+
+    T& Get(std::size_t pos, Int2Type<true>) {
+        return *data_[pos];
+    }
+
+    T& Get(std::size_t pos, Int2Type<false>) {
+        return data_[pos];
+    }
+
+    void Construct(StoredType* where, const T& value, Int2Type<true>) {
+        *where = value.Clone(arena_);
+    }
+
+    void Construct(StoredType* where, const T& value, Int2Type<false>) {
+        new (where) T(value);
+    }
+
+    // перенос при росте: указатели и тривиальные T переносятся memcpy
+    void Relocate(StoredType* data, Int2Type<false>) {
+        if (size_ != 0) {
+            std::memcpy(data, data_, size_ * sizeof(StoredType));
+        }
+    }
+
+    // как std::vector: перенос, если он noexcept, иначе копия, и тогда при исключении
+    // старые элементы остаются целы, а построенные в новом буфере разрушаются
+    void Relocate(StoredType* data, Int2Type<true>) {
+        std::size_t built = 0;
+        try {
+            for (; built < size_; built++) {
+                new (data + built) T(std::move_if_noexcept(data_[built]));
+            }
+        } catch (...) {
+            Destroy(data, 0, built, Int2Type<kPolicy>());
+            throw;
+        }
+        Destroy(data_, 0, size_, Int2Type<kPolicy>());
+    }
+
+    void CopyFrom(const PolicyVector& other, Int2Type<kTrivial>) {
+        if (other.size_ != 0) {
+            std::memcpy(data_, other.data_, other.size_ * sizeof(StoredType));
+        }
+    }
+
+    void CopyFrom(const PolicyVector& other, Int2Type<kValue>) {
+        std::uninitialized_copy(other.data_, other.data_ + other.size_, data_);
+    }
+
+    // клоны копии лежат в ее собственной арене
+    void CopyFrom(const PolicyVector& other, Int2Type<kPolymorphic>) {
+        std::size_t built = 0;
+        try {
+            for (; built < other.size_; built++) {
+                data_[built] = other.data_[built]->Clone(arena_);
+            }
+        } catch (...) {
+            Destroy(data_, 0, built, Int2Type<kPolymorphic>());
+            throw;
+        }
+    }
+
+    // разрушить элементы [from, to) буфера data
+    static void Destroy(StoredType*, std::size_t, std::size_t, Int2Type<kTrivial>) {}
+
+    static void Destroy(StoredType* data, std::size_t from, std::size_t to, Int2Type<kValue>) {
+        for (std::size_t i = from; i < to; i++) {
+            data[i].~T();
+        }
+    }
+
+    // память клонов вернет арена, здесь только деструкторы
+    static void Destroy(StoredType* data, std::size_t from, std::size_t to, Int2Type<kPolymorphic>) {
+        for (std::size_t i = from; i < to; i++) {
+            data[i]->~T();
+        }
+    }
+
+    StoredType* data_ = nullptr;
+    std::size_t size_ = 0;
+    std::size_t capacity_ = 0;
+    Arena arena_;
+};
+
+struct Base {
+    Base() : x(10) {}
+    Base(int _x) : x(_x) {}
+    virtual ~Base() {}
+
+    // клон в арене для PolicyVector и обычный - для сравнения
+    virtual Base* Clone(Arena& arena) const { return new (arena.Allocate(sizeof(Base), alignof(Base))) Base(*this); }
+    virtual Base* Clone() const { return new Base(*this); }
+    virtual int Value() const { return x; }
+
+protected:
+    int x;
+};
+
+struct Derived : Base {
+    Derived(int _y) : Base(_y), y(_y) {}
+
+    Base* Clone(Arena& arena) const override {
+        return new (arena.Allocate(sizeof(Derived), alignof(Derived))) Derived(*this);
+    }
+    Base* Clone() const override { return new Derived(*this); }
+    int Value() const override { return x + y; }
+
+private:
+    int y;
+};
+
+template<typename F>
+void Measure(const char* name, F f) {
+    const int passes = 20;
+    auto start = std::chrono::steady_clock::now();
+    long long result = 0;
+    for (int i = 0; i < passes; i++) {
+        result += f();
+    }
+    auto finish = std::chrono::steady_clock::now();
+    std::cout << name << ": " << std::chrono::duration<double, std::milli>(finish - start).count() / passes
+              << " ms (" << result << ")" << std::endl;
+}
+
+int main() {
+    const int count = 1000000;
+
+    static_assert(StoragePolicy<int>::value == kTrivial);
+    static_assert(StoragePolicy<std::string>::value == kValue);
+    static_assert(StoragePolicy<Base>::value == kPolymorphic);
+
+    PolicyVector<int> ints;
+    PolicyVector<std::string> strings;
+    PolicyVector<Base> shapes;
+    std::vector<std::unique_ptr<Base>> owning;
+    for (int i = 0; i < count; i++) {
+        ints.push_back(i);
+        if (i % 100 == 0) {
+            strings.push_back(std::to_string(i));
+        }
+        if (i % 2 == 0) {
+            shapes.push_back(Base(i));
+            owning.emplace_back(new Base(i));
+        } else {
+            shapes.push_back(Derived(i));
+            owning.emplace_back(new Derived(i));
+        }
+    }
+
+    Measure("PolicyVector<int> copy (memcpy)", [&] {
+        PolicyVector<int> copy = ints;
+        return static_cast<long long>(copy[count - 1]);
+    });
+    Measure("PolicyVector<std::string> copy", [&] {
+        PolicyVector<std::string> copy = strings;
+        return static_cast<long long>(copy.size());
+    });
+    Measure("PolicyVector<Base> copy (arena clones)", [&] {
+        PolicyVector<Base> copy = shapes;
+        return static_cast<long long>(copy[count - 1].Value());
+    });
+    Measure("vector<unique_ptr<Base>> copy (new per clone)", [&] {
+        std::vector<std::unique_ptr<Base>> copy;
+        copy.reserve(owning.size());
+        for (const auto& shape : owning) {
+            copy.emplace_back(shape->Clone());
+        }
+        return static_cast<long long>(copy[count - 1]->Value());
+    });
+    return 0;
+}
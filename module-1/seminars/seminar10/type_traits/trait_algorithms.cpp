@@ -0,0 +1,346 @@
+#include <chrono>
+#include <cstddef>
+#include <cstring>
+#include <iostream>
+#include <new>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "type_traits.h"
+
+// Алгоритмы copy_n / fill_n, uninitialized_copy_n / uninitialized_fill_n / uninitialized_move
+// и relocate, которые по TypeTraits и Conversion (из type_traits.h) выбирают реализацию:
+// для фундаментальных типов - memcpy / memset, для остальных - поэлементно.
+// И контейнер в стиле vector, который ими пользуется.
+
+template<int v>
+struct Int2Type {
+    enum { value = v };
+};
+
+namespace algo {
+
+namespace detail {
+
+// копирование U -> T байтами допустимо, только если это один и тот же тип
+template<typename T, typename U>
+struct CanMemcpy {
+    const static bool value = Conversion<T, U>::same && TypeTraits<T>::isBitwiseCopyable;
+};
+
+template<typename T, typename U>
+T* CopyN(const U* src, std::size_t count, T* dst, Int2Type<true>) {
+    if (count != 0) {
+        std::memcpy(dst, src, count * sizeof(T));
+    }
+    return dst + count;
+}
+
+template<typename T, typename U>
+T* CopyN(const U* src, std::size_t count, T* dst, Int2Type<false>) {
+    for (std::size_t i = 0; i < count; i++) {
+        dst[i] = src[i];
+    }
+    return dst + count;
+}
+
+// заполнение байтовых типов и нулей - memset, остальных чисел - удвоением memcpy:
+// первый элемент записан, дальше копируем уже заполненный префикс
+template<typename T>
+T* FillN(T* dst, std::size_t count, const T& value, Int2Type<true>) {
+    if (count == 0) {
+        return dst;
+    }
+    T zero = T();
+    if (sizeof(T) == 1 || std::memcmp(&value, &zero, sizeof(T)) == 0) {
+        unsigned char byte;
+        std::memcpy(&byte, &value, 1);
+        std::memset(dst, byte, count * sizeof(T));
+        return dst + count;
+    }
+    dst[0] = value;
+    std::size_t filled = 1;
+    while (filled < count) {
+        std::size_t chunk = filled < count - filled ? filled : count - filled;
+        std::memcpy(dst + filled, dst, chunk * sizeof(T));
+        filled += chunk;
+    }
+    return dst + count;
+}
+
+template<typename T>
+T* FillN(T* dst, std::size_t count, const T& value, Int2Type<false>) {
+    for (std::size_t i = 0; i < count; i++) {
+        dst[i] = value;
+    }
+    return dst + count;
+}
+
+// copy_n / fill_n присваивают уже живым объектам; uninitialized-версии
+// создают объекты в сырой памяти и при исключении разрушают созданные
+template<typename T, typename U>
+T* UninitializedCopyN(const U* src, std::size_t count, T* dst, Int2Type<true>) {
+    return CopyN(src, count, dst, Int2Type<true>());
+}
+
+template<typename T, typename U>
+T* UninitializedCopyN(const U* src, std::size_t count, T* dst, Int2Type<false>) {
+    std::size_t i = 0;
+    try {
+        for (; i < count; i++) {
+            new (dst + i) T(src[i]);
+        }
+    } catch (...) {
+        while (i > 0) {
+            dst[--i].~T();
+        }
+        throw;
+    }
+    return dst + count;
+}
+
+template<typename T>
+T* UninitializedFillN(T* dst, std::size_t count, const T& value, Int2Type<true>) {
+    return FillN(dst, count, value, Int2Type<true>());
+}
+
+template<typename T>
+T* UninitializedFillN(T* dst, std::size_t count, const T& value, Int2Type<false>) {
+    std::size_t i = 0;
+    try {
+        for (; i < count; i++) {
+            new (dst + i) T(value);
+        }
+    } catch (...) {
+        while (i > 0) {
+            dst[--i].~T();
+        }
+        throw;
+    }
+    return dst + count;
+}
+
+template<typename T>
+T* UninitializedMove(T* src, std::size_t count, T* dst, Int2Type<true>) {
+    return CopyN(src, count, dst, Int2Type<true>());
+}
+
+// при исключении источник частично перемещен, но жив; созданные копии разрушаются
+template<typename T>
+T* UninitializedMove(T* src, std::size_t count, T* dst, Int2Type<false>) {
+    std::size_t i = 0;
+    try {
+        for (; i < count; i++) {
+            new (dst + i) T(std::move(src[i]));
+        }
+    } catch (...) {
+        while (i > 0) {
+            dst[--i].~T();
+        }
+        throw;
+    }
+    return dst + count;
+}
+
+// relocate = move + деструктор источника; для чисел деструктор пустой
+template<typename T>
+T* Relocate(T* src, std::size_t count, T* dst, Int2Type<true>) {
+    return CopyN(src, count, dst, Int2Type<true>());
+}
+
+template<typename T>
+T* Relocate(T* src, std::size_t count, T* dst, Int2Type<false>) {
+    for (std::size_t i = 0; i < count; i++) {
+        new (dst + i) T(std::move(src[i]));
+        src[i].~T();
+    }
+    return dst + count;
+}
+
+}  // namespace detail
+
+template<typename T, typename U>
+T* copy_n(const U* src, std::size_t count, T* dst) {
+    return detail::CopyN(src, count, dst, Int2Type<detail::CanMemcpy<T, U>::value>());
+}
+
+template<typename T>
+T* fill_n(T* dst, std::size_t count, const T& value) {
+    return detail::FillN(dst, count, value, Int2Type<TypeTraits<T>::isBitwiseCopyable>());
+}
+
+template<typename T, typename U>
+T* uninitialized_copy_n(const U* src, std::size_t count, T* dst) {
+    return detail::UninitializedCopyN(src, count, dst, Int2Type<detail::CanMemcpy<T, U>::value>());
+}
+
+template<typename T>
+T* uninitialized_fill_n(T* dst, std::size_t count, const T& value) {
+    return detail::UninitializedFillN(dst, count, value, Int2Type<TypeTraits<T>::isBitwiseCopyable>());
+}
+
+template<typename T>
+T* uninitialized_move(T* src, std::size_t count, T* dst) {
+    return detail::UninitializedMove(src, count, dst, Int2Type<TypeTraits<T>::isBitwiseCopyable>());
+}
+
+template<typename T>
+T* relocate(T* src, std::size_t count, T* dst) {
+    return detail::Relocate(src, count, dst, Int2Type<TypeTraits<T>::isBitwiseCopyable>());
+}
+
+}  // namespace algo
+
+// Vector в стиле std::vector: копирование и рост идут через algo
+template<typename T>
+class Vector {
+public:
+    Vector() = default;
+
+    Vector(std::size_t count, const T& value) {
+        reserve(count);
+        try {
+            algo::uninitialized_fill_n(data_, count, value);
+        } catch (...) {
+            ::operator delete(data_);
+            throw;
+        }
+        size_ = count;
+    }
+
+    Vector(const Vector& other) {
+        reserve(other.size_);
+        try {
+            algo::uninitialized_copy_n(other.data_, other.size_, data_);
+        } catch (...) {
+            ::operator delete(data_);
+            throw;
+        }
+        size_ = other.size_;
+    }
+
+    Vector& operator=(Vector other) {
+        std::swap(data_, other.data_);
+        std::swap(size_, other.size_);
+        std::swap(capacity_, other.capacity_);
+        return *this;
+    }
+
+    ~Vector() {
+        for (std::size_t i = 0; i < size_ && !TypeTraits<T>::isBitwiseCopyable; i++) {
+            data_[i].~T();
+        }
+        ::operator delete(data_);
+    }
+
+    std::size_t size() const {
+        return size_;
+    }
+
+    T& operator[](std::size_t pos) {
+        return data_[pos];
+    }
+
+    // value может лежать в этом же векторе: при росте новый элемент
+    // строится в новом буфере до переноса старых и освобождения буфера
+    void push_back(const T& value) {
+        if (size_ < capacity_) {
+            new (data_ + size_) T(value);
+        } else {
+            std::size_t capacity = capacity_ == 0 ? 8 : 2 * capacity_;
+            T* data = static_cast<T*>(::operator new(capacity * sizeof(T)));
+            try {
+                new (data + size_) T(value);
+            } catch (...) {
+                ::operator delete(data);
+                throw;
+            }
+            reallocate(data, capacity);
+        }
+        ++size_;
+    }
+
+    void reserve(std::size_t capacity) {
+        if (capacity > capacity_) {
+            reallocate(static_cast<T*>(::operator new(capacity * sizeof(T))), capacity);
+        }
+    }
+
+private:
+    void reallocate(T* data, std::size_t capacity) {
+        algo::relocate(data_, size_, data);
+        ::operator delete(data_);
+        data_ = data;
+        capacity_ = capacity;
+    }
+
+    T* data_ = nullptr;
+    std::size_t size_ = 0;
+    std::size_t capacity_ = 0;
+};
+
+template<typename F>
+void Measure(const char* name, F f) {
+    const int passes = 20;
+    auto start = std::chrono::steady_clock::now();
+    long long result = 0;
+    for (int i = 0; i < passes; i++) {
+        result += f();
+    }
+    auto finish = std::chrono::steady_clock::now();
+    std::cout << name << ": " << std::chrono::duration<double, std::milli>(finish - start).count() / passes
+              << " ms (" << result << ")" << std::endl;
+}
+
+int main() {
+    static_assert(TypeTraits<int>::isFundamental);
+    static_assert(TypeTraits<double*>::isBitwiseCopyable);
+    static_assert(!TypeTraits<std::string>::isBitwiseCopyable);
+    static_assert(algo::detail::CanMemcpy<int, int>::value);
+    static_assert(!algo::detail::CanMemcpy<double, int>::value);
+
+    const std::size_t count = 10000000;
+    std::vector<int> src(count, 7);
+    std::vector<int> dst(count);
+    std::vector<double> doubles(count);
+
+    Measure("naive copy int", [&] {
+        for (std::size_t i = 0; i < count; i++) {
+            dst[i] = src[i];
+        }
+        return dst[count - 1];
+    });
+    Measure("algo::copy_n int", [&] {
+        algo::copy_n(src.data(), count, dst.data());
+        return dst[count - 1];
+    });
+    Measure("algo::copy_n int -> double (element-wise)", [&] {
+        algo::copy_n(src.data(), count, doubles.data());
+        return static_cast<long long>(doubles[count - 1]);
+    });
+    Measure("naive fill double", [&] {
+        for (std::size_t i = 0; i < count; i++) {
+            doubles[i] = 1.5;
+        }
+        return static_cast<long long>(doubles[count - 1]);
+    });
+    Measure("algo::fill_n double", [&] {
+        algo::fill_n(doubles.data(), count, 1.5);
+        return static_cast<long long>(doubles[count - 1]);
+    });
+
+    Vector<int> ints(count, 3);
+    Measure("Vector<int> copy", [&] {
+        Vector<int> copy = ints;
+        return static_cast<long long>(copy[count - 1]);
+    });
+
+    Vector<std::string> strings;
+    for (int i = 0; i < 1000; i++) {
+        strings.push_back(std::to_string(i));
+    }
+    Vector<std::string> strings_copy = strings;
+    std::cout << "strings: " << strings_copy[999] << std::endl;
+    return 0;
+}
@@ -0,0 +1,102 @@
+#pragma once
+
+// TypeTraits в стиле Loki и то, на чем он построен: Conversion, TypeList, IndexOf.
+// Общий для is_fundamental.cpp и trait_algorithms.cpp.
+
+template<typename T, typename U>
+class Conversion {
+    public:
+        typedef char Small;
+        class Big {
+            char unnnamed[2];
+        };
+
+        static Small Test(U);
+        static Big Test(...);
+
+        static T MakeT();
+
+        const static bool converts = sizeof(Test(MakeT())) == sizeof(Small);
+        const static bool same = false;
+};
+
+template<typename T>
+class Conversion<T, T> {
+    public:
+        const static bool converts = true;
+        const static bool same = true;
+};
+
+// Test(void) не объявить, поэтому void - отдельно
+template<typename T>
+class Conversion<T, void> {
+    public:
+        const static bool converts = false;
+        const static bool same = false;
+};
+
+template<>
+class Conversion<void, void> {
+    public:
+        const static bool converts = true;
+        const static bool same = true;
+};
+
+struct NullType {};
+
+template<typename Head, typename Tail>
+struct TypeList {
+    typedef Head H;
+    typedef Tail T;
+};
+
+template<typename TList, typename TargetType>
+struct IndexOf;
+
+template<typename TargetType>
+struct IndexOf<NullType, TargetType> {
+    const static int pos = -1;
+};
+
+template<typename Tail, typename TargetType>
+struct IndexOf<TypeList<TargetType, Tail>, TargetType> {
+    const static int pos = 0;
+};
+
+template<typename Head, typename Tail, typename TargetType>
+struct IndexOf<TypeList<Head, Tail>, TargetType> {
+private:
+    const static int actual = IndexOf<Tail, TargetType>::pos;
+public:
+    const static int pos = (actual == -1) ? -1 : actual + 1;
+};
+
+template<typename T>
+class TypeTraits {
+    private:
+        typedef TypeList<unsigned char, TypeList<unsigned short int, TypeList<unsigned int, TypeList<unsigned long int, TypeList<unsigned long long int, NullType>>>>> UnsignedInts;
+        typedef TypeList<signed char, TypeList<short int, TypeList<int, TypeList<long int, TypeList<long long int, NullType>>>>> SignedInts;
+        typedef TypeList<bool, TypeList<char, TypeList<wchar_t,  NullType>>> OtherInts;
+        typedef TypeList<long double, TypeList<float, TypeList<double, NullType>>> Floats;
+
+        template<typename U>
+        struct PointerTraits {
+            const static bool isPtr = false;
+        };
+
+        template<typename U>
+        struct PointerTraits<U*> {
+            const static bool isPtr = true;
+        };
+
+    public:
+        const static bool isUnsignedInt = IndexOf<UnsignedInts, T>::pos >= 0;
+        const static bool isSignedInt = IndexOf<SignedInts, T>::pos >= 0;
+        const static bool isFloat = IndexOf<Floats, T>::pos >= 0;
+        const static bool isIntegral = isUnsignedInt || isSignedInt || IndexOf<OtherInts, T>::pos >= 0;
+        const static bool isArithmetic = isIntegral  || isFloat;
+        const static bool isFundamental = isArithmetic  || Conversion<T, void>::same;
+        const static bool isPtr = PointerTraits<T>::isPtr;
+        // байты можно копировать как есть: числа и указатели
+        const static bool isBitwiseCopyable = isArithmetic || isPtr;
+};
@@ -0,0 +1,414 @@
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <iostream>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+
+// Числа Фибоначчи для больших n. В fib.cpp recursive::fib экспоненциальный,
+// iterative::fib линейный, и оба на int переполняются уже при n = 47.
+// Здесь:
+// * big::Unsigned - длинное неотрицательное число (цифры по 2^32, умножение Карацубы)
+// * fast_doubling::fib - O(log n) умножений:
+//       F(2k) = F(k) * (2F(k + 1) - F(k)),  F(2k + 1) = F(k)^2 + F(k + 1)^2
+// * matrix::Recurrence - возведение матрицы 2x2 в степень для x(n) = p x(n - 1) + q x(n - 2)
+// * cached::Fib - подряд идущие значения: окно из уже посчитанных, рост сложением
+
+namespace big {
+    typedef std::uint32_t Digit;
+    typedef std::vector<Digit> Digits;
+
+    // ниже этого размера школьное умножение быстрее Карацубы
+    const std::size_t kKaratsubaThreshold = 48;
+
+    void Trim(Digits& digits) {
+        while (!digits.empty() && digits.back() == 0) {
+            digits.pop_back();
+        }
+    }
+
+    // a += b * 2^(32 * shift)
+    void AddShifted(Digits& a, const Digits& b, std::size_t shift) {
+        if (a.size() < b.size() + shift) {
+            a.resize(b.size() + shift, 0);
+        }
+        std::uint64_t carry = 0;
+        std::size_t i = 0;
+        for (; i < b.size(); i++) {
+            carry += std::uint64_t(a[i + shift]) + b[i];
+            a[i + shift] = Digit(carry);
+            carry >>= 32;
+        }
+        for (i += shift; carry != 0; i++) {
+            if (i == a.size()) {
+                a.push_back(0);
+            }
+            carry += a[i];
+            a[i] = Digit(carry);
+            carry >>= 32;
+        }
+    }
+
+    // a -= b, a >= b
+    void Subtract(Digits& a, const Digits& b) {
+        std::int64_t borrow = 0;
+        for (std::size_t i = 0; i < a.size() && (i < b.size() || borrow != 0); i++) {
+            std::int64_t diff = std::int64_t(a[i]) - (i < b.size() ? b[i] : 0) - borrow;
+            borrow = diff < 0;
+            a[i] = Digit(diff + (borrow << 32));
+        }
+        Trim(a);
+    }
+
+    Digits MultiplySchool(const Digit* a, std::size_t a_size, const Digit* b, std::size_t b_size) {
+        Digits result(a_size + b_size, 0);
+        for (std::size_t i = 0; i < a_size; i++) {
+            std::uint64_t carry = 0;
+            for (std::size_t j = 0; j < b_size; j++) {
+                carry += std::uint64_t(a[i]) * b[j] + result[i + j];
+                result[i + j] = Digit(carry);
+                carry >>= 32;
+            }
+            result[i + b_size] = Digit(carry);
+        }
+        Trim(result);
+        return result;
+    }
+
+    Digits Slice(const Digit* digits, std::size_t size, std::size_t from, std::size_t to) {
+        if (to > size) {
+            to = size;
+        }
+        Digits result(from < to ? digits + from : digits, from < to ? digits + to : digits);
+        Trim(result);
+        return result;
+    }
+
+    // Карацуба: a = a1 B + a0, b = b1 B + b0,
+    // a b = a1 b1 B^2 + ((a0 + a1)(b0 + b1) - a0 b0 - a1 b1) B + a0 b0
+    Digits Multiply(const Digit* a, std::size_t a_size, const Digit* b, std::size_t b_size) {
+        if (a_size < b_size) {
+            std::swap(a, b);
+            std::swap(a_size, b_size);
+        }
+        if (b_size < kKaratsubaThreshold) {
+            return MultiplySchool(a, a_size, b, b_size);
+        }
+        std::size_t half = (a_size + 1) / 2;
+        Digits a0 = Slice(a, a_size, 0, half);
+        Digits a1 = Slice(a, a_size, half, a_size);
+        if (b_size <= half) {
+            // b короче половины a - делим только a
+            Digits result = Multiply(a0.data(), a0.size(), b, b_size);
+            AddShifted(result, Multiply(a1.data(), a1.size(), b, b_size), half);
+            Trim(result);
+            return result;
+        }
+        Digits b0 = Slice(b, b_size, 0, half);
+        Digits b1 = Slice(b, b_size, half, b_size);
+
+        Digits low = Multiply(a0.data(), a0.size(), b0.data(), b0.size());
+        Digits high = Multiply(a1.data(), a1.size(), b1.data(), b1.size());
+        AddShifted(a0, a1, 0);
+        AddShifted(b0, b1, 0);
+        Digits middle = Multiply(a0.data(), a0.size(), b0.data(), b0.size());
+        Subtract(middle, low);
+        Subtract(middle, high);
+
+        Digits result = std::move(low);
+        AddShifted(result, middle, half);
+        AddShifted(result, high, 2 * half);
+        Trim(result);
+        return result;
+    }
+
+    class Unsigned {
+    public:
+        Unsigned(std::uint64_t value = 0) {
+            while (value != 0) {
+                digits_.push_back(Digit(value));
+                value >>= 32;
+            }
+        }
+
+        Unsigned& operator+=(const Unsigned& other) {
+            AddShifted(digits_, other.digits_, 0);
+            return *this;
+        }
+
+        // *this >= other
+        Unsigned& operator-=(const Unsigned& other) {
+            Subtract(digits_, other.digits_);
+            return *this;
+        }
+
+        Unsigned& operator*=(const Unsigned& other) {
+            digits_ = Multiply(digits_.data(), digits_.size(), other.digits_.data(), other.digits_.size());
+            return *this;
+        }
+
+        friend Unsigned operator+(Unsigned lhs, const Unsigned& rhs) {
+            return lhs += rhs;
+        }
+
+        friend Unsigned operator-(Unsigned lhs, const Unsigned& rhs) {
+            return lhs -= rhs;
+        }
+
+        friend Unsigned operator*(const Unsigned& lhs, const Unsigned& rhs) {
+            Unsigned result;
+            result.digits_ = Multiply(lhs.digits_.data(), lhs.digits_.size(), rhs.digits_.data(), rhs.digits_.size());
+            return result;
+        }
+
+        friend bool operator==(const Unsigned& lhs, const Unsigned& rhs) {
+            return lhs.digits_ == rhs.digits_;
+        }
+
+        friend bool operator!=(const Unsigned& lhs, const Unsigned& rhs) {
+            return !(lhs == rhs);
+        }
+
+        std::size_t BitLength() const {
+            if (digits_.empty()) {
+                return 0;
+            }
+            std::size_t bits = 32 * (digits_.size() - 1);
+            for (Digit top = digits_.back(); top != 0; top >>= 1) {
+                ++bits;
+            }
+            return bits;
+        }
+
+        // остаток от деления на небольшое число - например, последние десятичные цифры
+        Digit Mod(Digit divisor) const {
+            std::uint64_t rest = 0;
+            for (std::size_t i = digits_.size(); i-- > 0;) {
+                rest = ((rest << 32) | digits_[i]) % divisor;
+            }
+            return Digit(rest);
+        }
+
+        // десятичная запись делением на 10^9: квадратично, для небольших чисел
+        std::string ToString() const {
+            if (digits_.empty()) {
+                return "0";
+            }
+            const Digit base = 1000000000;
+            Digits rest = digits_;
+            std::vector<Digit> chunks;
+            while (!rest.empty()) {
+                std::uint64_t remainder = 0;
+                for (std::size_t i = rest.size(); i-- > 0;) {
+                    std::uint64_t current = (remainder << 32) | rest[i];
+                    rest[i] = Digit(current / base);
+                    remainder = current % base;
+                }
+                Trim(rest);
+                chunks.push_back(Digit(remainder));
+            }
+            std::string result = std::to_string(chunks.back());
+            for (std::size_t i = chunks.size() - 1; i-- > 0;) {
+                std::string chunk = std::to_string(chunks[i]);
+                result += std::string(9 - chunk.size(), '0') + chunk;
+            }
+            return result;
+        }
+
+    private:
+        Digits digits_;
+    };
+}
+
+namespace fast_doubling {
+    // пара (F(n), F(n + 1)), биты n - от старшего к младшему
+    std::pair<big::Unsigned, big::Unsigned> fibPair(std::uint64_t n) {
+        big::Unsigned a = 0;
+        big::Unsigned b = 1;
+        int bit = 63;
+        while (bit >= 0 && ((n >> bit) & 1) == 0) {
+            --bit;
+        }
+        for (; bit >= 0; bit--) {
+            // (F(k), F(k + 1)) -> (F(2k), F(2k + 1))
+            big::Unsigned twice_b = b + b;
+            big::Unsigned even = a * (twice_b - a);
+            big::Unsigned odd = a * a + b * b;
+            if ((n >> bit) & 1) {
+                // -> (F(2k + 1), F(2k + 2))
+                a = std::move(odd);
+                b = a + even;
+            } else {
+                a = std::move(even);
+                b = std::move(odd);
+            }
+        }
+        return {std::move(a), std::move(b)};
+    }
+
+    big::Unsigned fib(std::uint64_t n) {
+        return fibPair(n).first;
+    }
+}
+
+namespace matrix {
+    // | a b |
+    // | c d |
+    struct Matrix2 {
+        big::Unsigned a, b, c, d;
+    };
+
+    Matrix2 operator*(const Matrix2& x, const Matrix2& y) {
+        return {x.a * y.a + x.b * y.c, x.a * y.b + x.b * y.d,
+                x.c * y.a + x.d * y.c, x.c * y.b + x.d * y.d};
+    }
+
+    Matrix2 power(Matrix2 base, std::uint64_t n) {
+        Matrix2 result = {1, 0, 0, 1};
+        for (; n != 0; n >>= 1) {
+            if (n & 1) {
+                result = result * base;
+            }
+            if (n > 1) {
+                base = base * base;
+            }
+        }
+        return result;
+    }
+
+    // x(n) = p x(n - 1) + q x(n - 2):
+    // (x(n + 1), x(n)) = M^n (x(1), x(0)),  M = | p q |
+    //                                            | 1 0 |
+    class Recurrence {
+    public:
+        Recurrence(big::Unsigned p, big::Unsigned q, big::Unsigned x0, big::Unsigned x1) :
+            step_{std::move(p), std::move(q), 1, 0},
+            x0_(std::move(x0)),
+            x1_(std::move(x1))
+        {}
+
+        big::Unsigned operator()(std::uint64_t n) const {
+            Matrix2 m = power(step_, n);
+            return m.c * x1_ + m.d * x0_;
+        }
+
+    private:
+        Matrix2 step_;
+        big::Unsigned x0_;
+        big::Unsigned x1_;
+    };
+
+    big::Unsigned fib(std::uint64_t n) {
+        return Recurrence(1, 1, 0, 1)(n);
+    }
+}
+
+namespace cached {
+    // Окно [first_, first_ + values_.size()) из последних kWindow посчитанных значений.
+    // Следующее за окном значение - одно сложение, далекое - заново fast doubling
+    class Fib {
+    public:
+        const big::Unsigned& operator()(std::uint64_t n) {
+            if (n < first_ || n > first_ + values_.size() + kMaxGap) {
+                Reset(n);
+            }
+            while (n >= first_ + values_.size()) {
+                std::size_t size = values_.size();
+                values_.push_back(values_[size - 1] + values_[size - 2]);
+                if (values_.size() > kWindow) {
+                    values_.pop_front();
+                    ++first_;
+                }
+            }
+            return values_[n - first_];
+        }
+
+        // F(from), ..., F(from + count - 1)
+        std::vector<big::Unsigned> range(std::uint64_t from, std::size_t count) {
+            std::vector<big::Unsigned> result;
+            result.reserve(count);
+            for (std::size_t i = 0; i < count; i++) {
+                result.push_back((*this)(from + i));
+            }
+            return result;
+        }
+
+    private:
+        // дальше этого проще пересчитать, чем дойти сложениями
+        const static std::uint64_t kMaxGap = 1000;
+        const static std::size_t kWindow = 64;
+
+        void Reset(std::uint64_t n) {
+            auto pair = fast_doubling::fibPair(n);
+            values_.clear();
+            values_.push_back(std::move(pair.first));
+            values_.push_back(std::move(pair.second));
+            first_ = n;
+        }
+
+        std::uint64_t first_ = 0;
+        std::deque<big::Unsigned> values_ = {0, 1};
+    };
+}
+
+template<typename F>
+big::Unsigned Measure(const char* name, F f) {
+    auto start = std::chrono::steady_clock::now();
+    big::Unsigned result = f();
+    auto finish = std::chrono::steady_clock::now();
+    std::cout << name << ": " << std::chrono::duration<double, std::milli>(finish - start).count() << " ms, "
+              << result.BitLength() << " bits, ends with ..." << result.Mod(1000000000) << std::endl;
+    return result;
+}
+
+int main() {
+    cached::Fib fib;
+    for (int i = 0; i < 10; i++) {
+        std::cout << fib(i).ToString() << " ";
+    }
+    std::cout << std::endl;
+    std::cout << "F(100) = " << fast_doubling::fib(100).ToString() << std::endl;
+
+    // Карацуба против школьного умножения, в том числе на неравных длинах
+    // и на цифрах 2^32 - 1, где переносы самые длинные
+    std::mt19937 gen(42);
+    for (int test = 0; test < 300; test++) {
+        big::Digits a(1 + gen() % 400);
+        big::Digits b(1 + gen() % 400);
+        for (big::Digit& digit : a) {
+            digit = test % 10 == 0 ? ~big::Digit(0) : big::Digit(gen());
+        }
+        for (big::Digit& digit : b) {
+            digit = test % 10 == 0 ? ~big::Digit(0) : big::Digit(gen());
+        }
+        if (big::Multiply(a.data(), a.size(), b.data(), b.size())
+            != big::MultiplySchool(a.data(), a.size(), b.data(), b.size())) {
+            std::cout << "karatsuba mismatch at sizes " << a.size() << " " << b.size() << std::endl;
+            return 1;
+        }
+    }
+
+    // fib идет от F(0), F(1) подряд, то есть только сложениями. К n = 5000 числа
+    // длиннее kKaratsubaThreshold цифр, и обе быстрые версии умножают Карацубой
+    for (std::uint64_t n = 0; n < 5000; n++) {
+        const big::Unsigned& expected = fib(n);
+        if ((n < 300 || n % 97 == 0) && (fast_doubling::fib(n) != expected || matrix::fib(n) != expected)) {
+            std::cout << "mismatch at " << n << std::endl;
+            return 1;
+        }
+    }
+
+    // последние 9 цифр F(10^6) и F(10^6 + 100), посчитаны отдельно по модулю 10^9
+    const big::Digit kTail = 242546875;
+    const big::Digit kTail100 = 447821325;
+    const std::uint64_t n = 1000000;
+    big::Unsigned doubling = Measure("fast doubling F(10^6)", [&] { return fast_doubling::fib(n); });
+    big::Unsigned power = Measure("matrix power F(10^6)", [&] { return matrix::fib(n); });
+    big::Unsigned cached = Measure("cached F(10^6), ..., F(10^6 + 100)", [&] { return fib.range(n, 101).back(); });
+    bool ok = doubling == power && doubling.Mod(1000000000) == kTail && cached.Mod(1000000000) == kTail100;
+    std::cout << (ok ? "ok" : "mismatch") << std::endl;
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,282 @@
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <iostream>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+// Решатель игр, обобщающий game.cpp. Там firstPlayerMove / secondPlayerMove
+// рекурсивно доигрывают партию и печатают итог; здесь считаются сразу все позиции
+// 0..N-1 итеративно, от меньших к большим.
+// Это не общий ретроградный анализ: поддерживаются только ациклические игры, в которых
+// каждый ход ведет в меньшую позицию (тогда порядок 0..N-1 - топологический и ничьих нет).
+// Ход в позицию не меньше текущей - ошибка, решатель бросает std::invalid_argument:
+// * SolveWinLose - выигрышна ли позиция для того, кто ходит; по биту на позицию
+// * SolveGrundy - числа Шпрага-Гранди для беспристрастных игр; по байту на позицию
+//
+// Игра описывается так:
+//     template<typename F> void ForEachMove(std::uint64_t position, F f) const;
+//         вызывает f(next) для каждого хода, next < position; f возвращает false,
+//         если перебор можно прекратить
+//     std::uint64_t IndependentUntil(std::uint64_t from) const;
+//         позиции [from, IndependentUntil(from)) ходят только в позиции < from,
+//         то есть их можно считать параллельно
+
+namespace games {
+    // game.cpp: первый игрок берет один камень, второй - половину; кто не может ходить - проиграл.
+    // Позиция - число камней и чей ход: 2 * stones + player
+    struct SeminarGame {
+        static std::uint64_t Position(std::uint64_t stones, int player) {
+            return 2 * stones + player;
+        }
+
+        template<typename F>
+        void ForEachMove(std::uint64_t position, F f) const {
+            std::uint64_t stones = position / 2;
+            if (stones == 0) {
+                return;
+            }
+            if (position % 2 == 0) {
+                f(Position(stones - 1, 1));
+            } else {
+                f(Position(stones / 2, 0));
+            }
+        }
+
+        std::uint64_t IndependentUntil(std::uint64_t from) const {
+            return from + 1;
+        }
+    };
+
+    // вычитание: из n можно перейти в n - s для s из набора
+    struct SubtractionGame {
+        std::vector<std::uint64_t> moves;
+
+        template<typename F>
+        void ForEachMove(std::uint64_t position, F f) const {
+            for (std::uint64_t move : moves) {
+                if (move <= position && !f(position - move)) {
+                    return;
+                }
+            }
+        }
+
+        std::uint64_t IndependentUntil(std::uint64_t from) const {
+            return from + *std::min_element(moves.begin(), moves.end());
+        }
+    };
+
+    // деление: из n > 0 можно перейти в n / d для d из набора (все d >= 2)
+    struct DivisionGame {
+        std::vector<std::uint64_t> divisors;
+
+        template<typename F>
+        void ForEachMove(std::uint64_t position, F f) const {
+            if (position == 0) {
+                return;
+            }
+            for (std::uint64_t divisor : divisors) {
+                if (!f(position / divisor)) {
+                    return;
+                }
+            }
+        }
+
+        // из [from, 2 from) ходы ведут в позиции не больше from - 1
+        std::uint64_t IndependentUntil(std::uint64_t from) const {
+            return from == 0 ? 1 : 2 * from;
+        }
+    };
+}
+
+// Битовая таблица. Соседние позиции делят слово, а потоки пишут в разные позиции,
+// поэтому слова атомарные: relaxed-операции компилируются в обычные load / or
+class BitTable {
+public:
+    explicit BitTable(std::uint64_t size) : words_((size + 63) / 64), size_(size) {
+        for (std::atomic<std::uint64_t>& word : words_) {
+            word.store(0, std::memory_order_relaxed);
+        }
+    }
+
+    bool Get(std::uint64_t pos) const {
+        return (words_[pos / 64].load(std::memory_order_relaxed) >> (pos % 64)) & 1;
+    }
+
+    void Set(std::uint64_t pos) {
+        words_[pos / 64].fetch_or(std::uint64_t(1) << (pos % 64), std::memory_order_relaxed);
+    }
+
+    std::uint64_t size() const {
+        return size_;
+    }
+
+    std::uint64_t Count() const {
+        std::uint64_t count = 0;
+        for (const std::atomic<std::uint64_t>& word : words_) {
+            count += __builtin_popcountll(word.load(std::memory_order_relaxed));
+        }
+        return count;
+    }
+
+private:
+    std::vector<std::atomic<std::uint64_t>> words_;
+    std::uint64_t size_;
+};
+
+namespace detail {
+    // меньшие блоки дешевле посчитать в одном потоке, чем запускать потоки
+    const std::uint64_t kParallelThreshold = 1 << 16;
+
+    inline void CheckMove(std::uint64_t position, std::uint64_t next) {
+        if (next >= position) {
+            throw std::invalid_argument("game solver: every move must lead to a smaller position");
+        }
+    }
+
+    // Обходит [0, size) блоками независимых позиций. Большой блок делится между
+    // потоками по границам 64 позиций; join завершает блок до начала следующего.
+    // Исключение из рабочего потока передается через exception_ptr и бросается здесь
+    template<typename Game, typename F>
+    void ForEachBlock(const Game& game, std::uint64_t size, unsigned threads, F solve) {
+        std::uint64_t from = 0;
+        while (from < size) {
+            std::uint64_t to = std::min(size, std::max(from + 1, game.IndependentUntil(from)));
+            if (threads <= 1 || to - from < kParallelThreshold) {
+                solve(from, to);
+            } else {
+                std::uint64_t part = ((to - from) / threads + 63) / 64 * 64;
+                std::vector<std::thread> workers;
+                std::vector<std::exception_ptr> errors((to - from + part - 1) / part);
+                for (std::uint64_t lo = from; lo < to; lo += part) {
+                    std::exception_ptr& error = errors[(lo - from) / part];
+                    workers.emplace_back([&solve, &error, lo, hi = std::min(to, lo + part)] {
+                        try {
+                            solve(lo, hi);
+                        } catch (...) {
+                            error = std::current_exception();
+                        }
+                    });
+                }
+                for (std::thread& worker : workers) {
+                    worker.join();
+                }
+                for (const std::exception_ptr& error : errors) {
+                    if (error) {
+                        std::rethrow_exception(error);
+                    }
+                }
+            }
+            from = to;
+        }
+    }
+}
+
+// позиция выигрышна, если есть ход в проигрышную
+template<typename Game>
+BitTable SolveWinLose(const Game& game, std::uint64_t size, unsigned threads = 1) {
+    BitTable win(size);
+    detail::ForEachBlock(game, size, threads, [&](std::uint64_t from, std::uint64_t to) {
+        for (std::uint64_t position = from; position < to; position++) {
+            bool wins = false;
+            game.ForEachMove(position, [&](std::uint64_t next) {
+                detail::CheckMove(position, next);
+                wins = !win.Get(next);
+                return !wins;
+            });
+            if (wins) {
+                win.Set(position);
+            }
+        }
+    });
+    return win;
+}
+
+// значение позиции - mex значений позиций, в которые из нее есть ход.
+// mex не больше числа ходов, поэтому при не более чем 255 ходах хватает байта;
+// если значение 256 и больше, бросается std::overflow_error
+template<typename Game>
+std::vector<std::uint8_t> SolveGrundy(const Game& game, std::uint64_t size, unsigned threads = 1) {
+    std::vector<std::uint8_t> grundy(size);
+    detail::ForEachBlock(game, size, threads, [&](std::uint64_t from, std::uint64_t to) {
+        for (std::uint64_t position = from; position < to; position++) {
+            std::uint64_t seen[4] = {};
+            game.ForEachMove(position, [&](std::uint64_t next) {
+                detail::CheckMove(position, next);
+                std::uint8_t value = grundy[next];
+                seen[value / 64] |= std::uint64_t(1) << (value % 64);
+                return true;
+            });
+            unsigned mex = 0;
+            while (mex < 256 && ((seen[mex / 64] >> (mex % 64)) & 1)) {
+                ++mex;
+            }
+            if (mex == 256) {
+                throw std::overflow_error("SolveGrundy: grundy value does not fit in a byte");
+            }
+            grundy[position] = static_cast<std::uint8_t>(mex);
+        }
+    });
+    return grundy;
+}
+
+template<typename F>
+auto Measure(const char* name, F f) {
+    auto start = std::chrono::steady_clock::now();
+    auto result = f();
+    auto finish = std::chrono::steady_clock::now();
+    std::cout << name << ": " << std::chrono::duration<double, std::milli>(finish - start).count() << " ms" << std::endl;
+    return result;
+}
+
+int main() {
+    const std::uint64_t n = 100000000;
+    unsigned threads = std::max(1u, std::thread::hardware_concurrency());
+
+    // тот же вывод, что у game.cpp
+    games::SeminarGame seminar;
+    BitTable small = SolveWinLose(seminar, seminar.Position(6, 0));
+    for (std::uint64_t stones = 1; stones < 6; stones++) {
+        std::cout << stones << " : " << (small.Get(seminar.Position(stones, 0)) ? "second" : "first") << ": lose"
+                  << std::endl;
+    }
+
+    BitTable seminar_win = Measure("seminar game, 2 * 10^8 positions", [&] {
+        return SolveWinLose(seminar, seminar.Position(n, 0));
+    });
+    std::cout << "first player wins in " << seminar_win.Count() << " positions" << std::endl;
+
+    {
+        games::SubtractionGame subtraction{{1, 3, 4}};
+        std::vector<std::uint8_t> grundy = Measure("subtraction {1, 3, 4} grundy, 10^8", [&] {
+            return SolveGrundy(subtraction, n);
+        });
+        std::cout << "grundy(10^8 - 1) = " << int(grundy[n - 1]) << std::endl;
+    }
+
+    games::DivisionGame division{{2, 3, 5}};
+    BitTable sequential = Measure("division {2, 3, 5} win/lose, 10^8, 1 thread", [&] {
+        return SolveWinLose(division, n);
+    });
+    BitTable parallel = Measure("division {2, 3, 5} win/lose, 10^8, all threads", [&] {
+        return SolveWinLose(division, n, threads);
+    });
+    std::vector<std::uint8_t> grundy_sequential = Measure("division {2, 3, 5} grundy, 10^8, 1 thread", [&] {
+        return SolveGrundy(division, n);
+    });
+    std::vector<std::uint8_t> grundy_parallel = Measure("division {2, 3, 5} grundy, 10^8, all threads", [&] {
+        return SolveGrundy(division, n, threads);
+    });
+
+    bool same = sequential.Count() == parallel.Count() && grundy_sequential == grundy_parallel;
+    for (std::uint64_t position = 0; position < n && same; position++) {
+        same = sequential.Get(position) == parallel.Get(position)
+               && parallel.Get(position) == (grundy_parallel[position] != 0);
+    }
+    std::cout << threads << " threads, " << (same ? "ok" : "mismatch") << std::endl;
+    return same ? 0 : 1;
+}
@@ -0,0 +1,287 @@
+#include <cstddef>
+#include <iostream>
+#include <type_traits>
+#include <utility>
+
+// Рекурсивный TypeList<Head, Tail> инстанцирует по шаблону на каждый элемент,
+// и глубина инстанцирования растет линейно: на списках из сотен типов
+// упираемся в -ftemplate-depth и во время компиляции.
+// Здесь те же операции над вариадическим списком с постоянной глубиной.
+
+struct NullType {};
+
+template<typename Head, typename Tail>
+struct TypeList {
+    typedef Head H;
+    typedef Tail T;
+};
+
+namespace flat {
+
+template<typename... Ts>
+struct TypeList {};
+
+// Length: sizeof... не требует ни одного инстанцирования
+template<typename TList>
+struct Length;
+
+template<typename... Ts>
+struct Length<TypeList<Ts...>> {
+    const static std::size_t length = sizeof...(Ts);
+};
+
+// TypeAt: список "раскладывается" в базы Indexed<i, T> одного класса,
+// нужный тип находит перегрузка, а не рекурсия по хвосту
+template<std::size_t index, typename T>
+struct Indexed {};
+
+template<typename Indices, typename... Ts>
+struct Indexer;
+
+template<std::size_t... Is, typename... Ts>
+struct Indexer<std::index_sequence<Is...>, Ts...> : Indexed<Is, Ts>... {};
+
+template<std::size_t index, typename T>
+T Select(Indexed<index, T>);
+
+template<typename TList, std::size_t index>
+struct TypeAt;
+
+template<typename... Ts, std::size_t index>
+struct TypeAt<TypeList<Ts...>, index> {
+    static_assert(index < sizeof...(Ts), "index out of range");
+    typedef decltype(Select<index>(Indexer<std::index_sequence_for<Ts...>, Ts...>())) TargetType;
+};
+
+// Маска совпадений с TargetType собирается одним раскрытием пачки через is_same_v,
+// а первая позиция ищется циклом в constexpr-функции. Сравнивать адреса
+// статических членов (&TypeId<T>::id == &TypeId<U>::id) нельзя: GCC не считает
+// такое сравнение константным выражением, например под -fsanitize=undefined
+template<typename TargetType, typename... Ts>
+struct Matches {
+    constexpr static bool value[sizeof...(Ts) + 1] = {std::is_same_v<Ts, TargetType>..., false};
+};
+
+constexpr int First(const bool* mask, std::size_t count) {
+    for (std::size_t i = 0; i < count; i++) {
+        if (mask[i]) {
+            return static_cast<int>(i);
+        }
+    }
+    return -1;
+}
+
+template<typename TList, typename TargetType>
+struct IndexOf;
+
+template<typename... Ts, typename TargetType>
+struct IndexOf<TypeList<Ts...>, TargetType> {
+    const static int pos = First(Matches<TargetType, Ts...>::value, sizeof...(Ts));
+};
+
+template<typename TList, typename NewType>
+struct Append;
+
+template<typename... Ts, typename NewType>
+struct Append<TypeList<Ts...>, NewType> {
+    typedef TypeList<Ts..., NewType> NewTypeList;
+};
+
+template<typename... Ts, typename... Us>
+struct Append<TypeList<Ts...>, TypeList<Us...>> {
+    typedef TypeList<Ts..., Us...> NewTypeList;
+};
+
+// Filter: маска оставляемых позиций считается в constexpr,
+// новый список собирается за одно раскрытие пачки
+template<std::size_t N>
+struct Mask {
+    bool keep[N + 1] = {};
+    std::size_t positions[N + 1] = {};
+    std::size_t count = 0;
+
+    constexpr void Build() {
+        for (std::size_t i = 0; i < N; i++) {
+            if (keep[i]) {
+                positions[count++] = i;
+            }
+        }
+    }
+};
+
+template<typename TList, typename Positions, typename Indices>
+struct Gather;
+
+template<typename TList, typename Positions, std::size_t... Is>
+struct Gather<TList, Positions, std::index_sequence<Is...>> {
+    typedef TypeList<typename TypeAt<TList, Positions::mask.positions[Is]>::TargetType...> NewTypeList;
+};
+
+template<typename TList, typename Positions>
+struct Filter {
+    typedef typename Gather<TList, Positions, std::make_index_sequence<Positions::mask.count>>::NewTypeList NewTypeList;
+};
+
+// Маски для Erase (all = false), EraseAll (all = true) и NoDuplicates
+template<typename TargetType, typename... Ts>
+constexpr Mask<sizeof...(Ts)> EraseMask(bool all) {
+    Mask<sizeof...(Ts)> mask;
+    const bool* matches = Matches<TargetType, Ts...>::value;
+    int first = First(matches, sizeof...(Ts));
+    for (std::size_t i = 0; i < sizeof...(Ts); i++) {
+        mask.keep[i] = all ? !matches[i] : static_cast<int>(i) != first;
+    }
+    mask.Build();
+    return mask;
+}
+
+// для каждой позиции - индекс первого вхождения ее типа в пачку;
+// позицию оставляем, если это она сама
+template<typename... Ts>
+struct FirstPositions {
+    constexpr static int value[sizeof...(Ts) + 1] = {IndexOf<TypeList<Ts...>, Ts>::pos..., -1};
+};
+
+template<typename... Ts>
+constexpr Mask<sizeof...(Ts)> UniqueMask() {
+    Mask<sizeof...(Ts)> mask;
+    for (std::size_t i = 0; i < sizeof...(Ts); i++) {
+        mask.keep[i] = FirstPositions<Ts...>::value[i] == static_cast<int>(i);
+    }
+    mask.Build();
+    return mask;
+}
+
+template<typename TList, typename TargetType, bool all>
+struct ErasePositions;
+
+template<typename... Ts, typename TargetType, bool all>
+struct ErasePositions<TypeList<Ts...>, TargetType, all> {
+    constexpr static Mask<sizeof...(Ts)> mask = EraseMask<TargetType, Ts...>(all);
+};
+
+template<typename TList>
+struct UniquePositions;
+
+template<typename... Ts>
+struct UniquePositions<TypeList<Ts...>> {
+    constexpr static Mask<sizeof...(Ts)> mask = UniqueMask<Ts...>();
+};
+
+template<typename TList, typename TargetType>
+struct Erase {
+    typedef typename Filter<TList, ErasePositions<TList, TargetType, false>>::NewTypeList NewTypeList;
+};
+
+template<typename TList, typename TargetType>
+struct EraseAll {
+    typedef typename Filter<TList, ErasePositions<TList, TargetType, true>>::NewTypeList NewTypeList;
+};
+
+template<typename TList>
+struct NoDuplicates {
+    typedef typename Filter<TList, UniquePositions<TList>>::NewTypeList NewTypeList;
+};
+
+// Replace: заменяет первое вхождение, как и рекурсивная версия
+template<typename TList, typename OldType, typename NewType>
+struct Replace;
+
+template<typename... Ts, typename OldType, typename NewType>
+struct Replace<TypeList<Ts...>, OldType, NewType> {
+private:
+    template<typename Indices>
+    struct Build;
+
+    template<std::size_t... Is>
+    struct Build<std::index_sequence<Is...>> {
+        typedef TypeList<std::conditional_t<static_cast<int>(Is) == IndexOf<TypeList<Ts...>, OldType>::pos,
+                                            NewType, Ts>...> type;
+    };
+public:
+    typedef typename Build<std::index_sequence_for<Ts...>>::type NewTypeList;
+};
+
+// Конвертация в рекурсивный список: свертка (fold) строит вложенный тип
+// без рекурсии по шаблонам
+template<typename T>
+struct Wrap {
+    typedef T type;
+};
+
+template<typename Head, typename Tail>
+Wrap<::TypeList<Head, Tail>> operator+(Wrap<Head>, Wrap<Tail>);
+
+template<typename TList>
+struct ToCons;
+
+template<typename... Ts>
+struct ToCons<TypeList<Ts...>> {
+    typedef typename decltype((Wrap<Ts>() + ... + Wrap<NullType>()))::type NewTypeList;
+};
+
+// Обратная конвертация: рекурсивный список вложен сам по себе,
+// поэтому снимаем по одному звену, глубина равна длине списка
+template<typename TList, typename... Ts>
+struct FromCons;
+
+template<typename... Ts>
+struct FromCons<NullType, Ts...> {
+    typedef TypeList<Ts...> NewTypeList;
+};
+
+template<typename Head, typename Tail, typename... Ts>
+struct FromCons<::TypeList<Head, Tail>, Ts...> {
+    typedef typename FromCons<Tail, Ts..., Head>::NewTypeList NewTypeList;
+};
+
+}  // namespace flat
+
+template<int v>
+struct Int2Type {
+    enum { value = v };
+};
+
+// длинный список для проверки: 600 типов, рекурсивная версия здесь
+// уже близка к лимиту -ftemplate-depth=900
+template<typename Indices>
+struct MakeLong;
+
+template<std::size_t... Is>
+struct MakeLong<std::index_sequence<Is...>> {
+    typedef flat::TypeList<Int2Type<Is % 300>...> type;
+};
+
+int main() {
+    typedef flat::TypeList<int, double, int, char, double> tlist;
+
+    static_assert(flat::Length<tlist>::length == 5);
+    static_assert(std::is_same<flat::TypeAt<tlist, 3>::TargetType, char>::value);
+    static_assert(flat::IndexOf<tlist, double>::pos == 1);
+    static_assert(flat::IndexOf<tlist, float>::pos == -1);
+    static_assert(std::is_same<flat::Append<tlist, float>::NewTypeList,
+                               flat::TypeList<int, double, int, char, double, float>>::value);
+    static_assert(std::is_same<flat::Erase<tlist, int>::NewTypeList,
+                               flat::TypeList<double, int, char, double>>::value);
+    static_assert(std::is_same<flat::EraseAll<tlist, double>::NewTypeList,
+                               flat::TypeList<int, int, char>>::value);
+    static_assert(std::is_same<flat::NoDuplicates<tlist>::NewTypeList,
+                               flat::TypeList<int, double, char>>::value);
+    static_assert(std::is_same<flat::Replace<tlist, int, float>::NewTypeList,
+                               flat::TypeList<float, double, int, char, double>>::value);
+
+    typedef flat::ToCons<flat::TypeList<int, double>>::NewTypeList cons;
+    static_assert(std::is_same<cons, TypeList<int, TypeList<double, NullType>>>::value);
+    static_assert(std::is_same<flat::FromCons<cons>::NewTypeList, flat::TypeList<int, double>>::value);
+    static_assert(std::is_same<flat::ToCons<flat::TypeList<>>::NewTypeList, NullType>::value);
+
+    typedef MakeLong<std::make_index_sequence<600>>::type long_list;
+    static_assert(flat::Length<long_list>::length == 600);
+    static_assert(std::is_same<flat::TypeAt<long_list, 599>::TargetType, Int2Type<299>>::value);
+    static_assert(flat::IndexOf<long_list, Int2Type<299>>::pos == 299);
+    static_assert(flat::Length<flat::NoDuplicates<long_list>::NewTypeList>::length == 300);
+    static_assert(flat::Length<flat::EraseAll<long_list, Int2Type<0>>::NewTypeList>::length == 598);
+
+    std::cout << flat::Length<flat::NoDuplicates<long_list>::NewTypeList>::length << std::endl;
+    return 0;
+}
@@ -0,0 +1,304 @@
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+#include <random>
+#include <typeindex>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+// IndexOf во время выполнения: по хешу типа найти его позицию в списке.
+// Линейный поиск (как IndexOf в index_of_2.cpp) - O(n) на запрос.
+// Здесь по TypeList на этапе компиляции строится совершенная хеш-таблица
+// (hash and displace): запрос - один хеш и одно чтение слота.
+
+struct NullType {};
+
+template<typename Head, typename Tail>
+struct TypeList {
+    typedef Head H;
+    typedef Tail T;
+};
+
+template<typename TList>
+struct Length;
+
+template<>
+struct Length<NullType> {
+    const static std::size_t length = 0;
+};
+
+template<typename Head, typename Tail>
+struct Length<TypeList<Head, Tail>> {
+    const static std::size_t length = Length<Tail>::length + 1;
+};
+
+template<typename TList, std::size_t index>
+struct TypeAt;
+
+template<typename Head, typename Tail>
+struct TypeAt<TypeList<Head, Tail>, 0> {
+    typedef Head TargetType;
+};
+
+template<typename Head, typename Tail, std::size_t index>
+struct TypeAt<TypeList<Head, Tail>, index> {
+    typedef typename TypeAt<Tail, index - 1>::TargetType TargetType;
+};
+
+template<typename TList, typename TargetType>
+struct IndexOf;
+
+template<typename TargetType>
+struct IndexOf<NullType, TargetType> {
+    const static int pos = -1;
+};
+
+template<typename Tail, typename TargetType>
+struct IndexOf<TypeList<TargetType, Tail>, TargetType> {
+    const static int pos = 0;
+};
+
+template<typename Head, typename Tail, typename TargetType>
+struct IndexOf<TypeList<Head, Tail>, TargetType> {
+private:
+    const static int actual = IndexOf<Tail, TargetType>::pos;
+public:
+    const static int pos = (actual == -1) ? -1 : actual + 1;
+};
+
+// все типы списка различны: голова не встречается в хвосте, и так далее
+template<typename TList>
+struct Distinct;
+
+template<>
+struct Distinct<NullType> {
+    const static bool value = true;
+};
+
+template<typename Head, typename Tail>
+struct Distinct<TypeList<Head, Tail>> {
+    const static bool value = IndexOf<Tail, Head>::pos == -1 && Distinct<Tail>::value;
+};
+
+// Стабильный хеш типа: FNV-1a от имени функции, в которое компилятор
+// подставляет имя T. Не зависит от порядка загрузки и адресов,
+// но зависит от компилятора (формат __PRETTY_FUNCTION__)
+template<typename T>
+constexpr std::uint64_t TypeHash() {
+    const char* name = __PRETTY_FUNCTION__;
+    std::uint64_t hash = 14695981039346656037ull;
+    for (std::size_t i = 0; name[i] != '\0'; i++) {
+        hash = (hash ^ static_cast<unsigned char>(name[i])) * 1099511628211ull;
+    }
+    return hash;
+}
+
+constexpr std::uint64_t Mix(std::uint64_t key, std::uint64_t seed) {
+    key ^= seed * 0x9e3779b97f4a7c15ull;
+    key = (key ^ (key >> 30)) * 0xbf58476d1ce4e5b9ull;
+    key = (key ^ (key >> 27)) * 0x94d049bb133111ebull;
+    return key ^ (key >> 31);
+}
+
+constexpr std::size_t NextPowerOfTwo(std::size_t n) {
+    std::size_t power = 1;
+    while (power < n) {
+        power *= 2;
+    }
+    return power;
+}
+
+// Ключи раскладываются по корзинам первым хешем; для каждой корзины
+// (от больших к маленьким) подбирается displacement - seed второго хеша,
+// при котором все ее ключи попадают в свободные слоты.
+// Ключи должны быть различны: для повторяющегося ключа seed не найдется
+// (TypeIndex проверяет это для типов через static_assert)
+template<std::size_t N>
+struct PerfectHash {
+    const static std::size_t kBuckets = N / 2 + 1;
+    const static std::size_t kSlots = NextPowerOfTwo(N + N / 4 + 1);
+
+    std::uint64_t displacement[kBuckets] = {};
+    std::uint64_t keys[kSlots] = {};
+    int values[kSlots] = {};
+
+    constexpr explicit PerfectHash(const std::uint64_t (&input)[N]) {
+        for (std::size_t slot = 0; slot < kSlots; slot++) {
+            values[slot] = -1;
+        }
+
+        std::size_t bucket_of[N] = {};
+        std::size_t bucket_size[kBuckets] = {};
+        for (std::size_t i = 0; i < N; i++) {
+            bucket_of[i] = Mix(input[i], 0) % kBuckets;
+            ++bucket_size[bucket_of[i]];
+        }
+
+        std::size_t order[kBuckets] = {};
+        for (std::size_t b = 0; b < kBuckets; b++) {
+            order[b] = b;
+        }
+        for (std::size_t i = 1; i < kBuckets; i++) {
+            for (std::size_t j = i; j > 0 && bucket_size[order[j]] > bucket_size[order[j - 1]]; j--) {
+                std::size_t tmp = order[j];
+                order[j] = order[j - 1];
+                order[j - 1] = tmp;
+            }
+        }
+
+        for (std::size_t b : order) {
+            if (bucket_size[b] == 0) {
+                break;
+            }
+            for (std::uint64_t seed = 1;; seed++) {
+                std::size_t slots[N] = {};
+                std::size_t placed = 0;
+                bool ok = true;
+                for (std::size_t i = 0; i < N && ok; i++) {
+                    if (bucket_of[i] != b) {
+                        continue;
+                    }
+                    std::size_t slot = Mix(input[i], seed) & (kSlots - 1);
+                    ok = values[slot] == -1;
+                    for (std::size_t j = 0; j < placed && ok; j++) {
+                        ok = slots[j] != slot;
+                    }
+                    slots[placed++] = slot;
+                }
+                if (!ok) {
+                    continue;
+                }
+                placed = 0;
+                for (std::size_t i = 0; i < N; i++) {
+                    if (bucket_of[i] == b) {
+                        keys[slots[placed]] = input[i];
+                        values[slots[placed++]] = static_cast<int>(i);
+                    }
+                }
+                displacement[b] = seed;
+                break;
+            }
+        }
+    }
+
+    constexpr int Find(std::uint64_t key) const {
+        std::size_t slot = Mix(key, displacement[Mix(key, 0) % kBuckets]) & (kSlots - 1);
+        return keys[slot] == key ? values[slot] : -1;
+    }
+};
+
+// хеши всех типов списка в порядке следования
+template<typename TList, typename Indices = std::make_index_sequence<Length<TList>::length>>
+struct Hashes;
+
+template<typename TList, std::size_t... Is>
+struct Hashes<TList, std::index_sequence<Is...>> {
+    constexpr static std::uint64_t value[] = {TypeHash<typename TypeAt<TList, Is>::TargetType>()...};
+};
+
+template<typename TList>
+struct TypeIndex {
+    static_assert(Length<TList>::length > 0, "TypeIndex: empty type list");
+    static_assert(Distinct<TList>::value, "TypeIndex: types in the list must be distinct");
+
+    constexpr static PerfectHash<Length<TList>::length> table{Hashes<TList>::value};
+
+    static int Find(std::uint64_t type_hash) {
+        return table.Find(type_hash);
+    }
+};
+
+template<int v>
+struct Int2Type {
+    enum { value = v };
+};
+
+// реестр из 200 типов
+template<typename Indices>
+struct MakeRegistry;
+
+template<>
+struct MakeRegistry<std::index_sequence<>> {
+    typedef NullType type;
+};
+
+template<std::size_t I, std::size_t... Is>
+struct MakeRegistry<std::index_sequence<I, Is...>> {
+    typedef TypeList<Int2Type<I>, typename MakeRegistry<std::index_sequence<Is...>>::type> type;
+};
+
+typedef MakeRegistry<std::make_index_sequence<200>>::type Registry;
+
+template<typename TList, std::size_t... Is>
+std::vector<std::type_index> TypeIndices(std::index_sequence<Is...>) {
+    return {typeid(typename TypeAt<TList, Is>::TargetType)...};
+}
+
+template<typename F>
+long long Measure(const char* name, std::size_t count, F f) {
+    auto start = std::chrono::steady_clock::now();
+    long long result = f();
+    auto finish = std::chrono::steady_clock::now();
+    std::cout << name << ": " << std::chrono::duration<double, std::nano>(finish - start).count() / count
+              << " ns/lookup" << std::endl;
+    return result;
+}
+
+int main() {
+    const std::size_t length = Length<Registry>::length;
+    const std::size_t queries = 10000000;
+
+    static_assert(TypeIndex<Registry>::table.Find(TypeHash<Int2Type<123>>()) == 123);
+    static_assert(TypeIndex<Registry>::table.Find(TypeHash<double>()) == -1);
+
+    std::vector<std::uint64_t> keys(Hashes<Registry>::value, Hashes<Registry>::value + length);
+    std::unordered_map<std::type_index, int> map;
+    std::vector<std::type_index> type_indices = TypeIndices<Registry>(std::make_index_sequence<length>());
+    for (std::size_t i = 0; i < length; i++) {
+        map.emplace(type_indices[i], static_cast<int>(i));
+    }
+
+    std::mt19937 gen(42);
+    std::uniform_int_distribution<std::size_t> dist(0, length - 1);
+    std::vector<std::size_t> positions(queries);
+    for (std::size_t& pos : positions) {
+        pos = dist(gen);
+    }
+    std::vector<std::uint64_t> hash_queries(queries);
+    std::vector<std::type_index> index_queries(queries, type_indices[0]);
+    for (std::size_t i = 0; i < queries; i++) {
+        hash_queries[i] = keys[positions[i]];
+        index_queries[i] = type_indices[positions[i]];
+    }
+
+    long long linear = Measure("linear search", queries, [&] {
+        long long sum = 0;
+        for (std::uint64_t key : hash_queries) {
+            std::size_t i = 0;
+            while (i < length && keys[i] != key) {
+                i++;
+            }
+            sum += i;
+        }
+        return sum;
+    });
+    long long unordered = Measure("unordered_map<type_index>", queries, [&] {
+        long long sum = 0;
+        for (const std::type_index& key : index_queries) {
+            sum += map.find(key)->second;
+        }
+        return sum;
+    });
+    long long perfect = Measure("perfect hash", queries, [&] {
+        long long sum = 0;
+        for (std::uint64_t key : hash_queries) {
+            sum += TypeIndex<Registry>::Find(key);
+        }
+        return sum;
+    });
+
+    std::cout << "checksum: " << linear << " " << unordered << " " << perfect << std::endl;
+    return 0;
+}
@@ -0,0 +1,379 @@
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+#include <iterator>
+#include <map>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "widget.h"
+
+// Фабрика объектов по списку типов: Create перегружается через Type2Type,
+// как в type2type_3.cpp, но память берется не из new, а из пула своего типа.
+// Пул выделяет объекты кусками (объекты лежат подряд, CreateN дает настоящий массив),
+// освободившиеся места попадают в список свободных, а DestroyAll разрушает все разом.
+
+template<typename T>
+struct Type2Type {
+    typedef T value_type;
+};
+
+struct NullType {};
+
+template<typename Head, typename Tail>
+struct TypeList {
+    typedef Head H;
+    typedef Tail T;
+};
+
+template<typename TList>
+struct Length;
+
+template<>
+struct Length<NullType> {
+    const static std::size_t length = 0;
+};
+
+template<typename Head, typename Tail>
+struct Length<TypeList<Head, Tail>> {
+    const static std::size_t length = Length<Tail>::length + 1;
+};
+
+template<typename TList, std::size_t index>
+struct TypeAt;
+
+template<typename Head, typename Tail>
+struct TypeAt<TypeList<Head, Tail>, 0> {
+    typedef Head TargetType;
+};
+
+template<typename Head, typename Tail, std::size_t index>
+struct TypeAt<TypeList<Head, Tail>, index> {
+    typedef typename TypeAt<Tail, index - 1>::TargetType TargetType;
+};
+
+template<typename TList, typename TargetType>
+struct IndexOf;
+
+template<typename TargetType>
+struct IndexOf<NullType, TargetType> {
+    const static int pos = -1;
+};
+
+template<typename Tail, typename TargetType>
+struct IndexOf<TypeList<TargetType, Tail>, TargetType> {
+    const static int pos = 0;
+};
+
+template<typename Head, typename Tail, typename TargetType>
+struct IndexOf<TypeList<Head, Tail>, TargetType> {
+private:
+    const static int actual = IndexOf<Tail, TargetType>::pos;
+public:
+    const static int pos = (actual == -1) ? -1 : actual + 1;
+};
+
+// "конструкторы" по Type2Type: по умолчанию T(arg), для Widget - Widget(arg, -1)
+template<typename T, typename U>
+T* Create(void* memory, const U& arg, Type2Type<T>) {
+    return new (memory) T(arg);
+}
+
+template<typename U>
+Widget* Create(void* memory, const U& arg, Type2Type<Widget>) {
+    return new (memory) Widget(arg, -1);
+}
+
+// Pool<T>: куски по kChunk слотов. Слот - объединение места под T и ссылки
+// списка свободных, поэтому слоты идут с шагом sizeof(T) (если T не меньше указателя),
+// а "жив ли слот" хранится отдельной битовой картой куска
+template<typename T>
+class Pool {
+public:
+    Pool() = default;
+    Pool(const Pool&) = delete;
+    Pool& operator=(const Pool&) = delete;
+
+    ~Pool() {
+        DestroyAll();
+    }
+
+    template<typename U>
+    T* Create(const U& arg) {
+        Slot* slot = free_;
+        if (slot) {
+            free_ = slot->next;
+        } else {
+            slot = Bump(1);
+        }
+        // если конструктор бросил, слот возвращается в список свободных
+        try {
+            return Construct(slot, arg);
+        } catch (...) {
+            Release(slot);
+            throw;
+        }
+    }
+
+    // count объектов подряд, то есть настоящий массив T[count]
+    template<typename U>
+    T* CreateN(std::size_t count, const U& arg) {
+        static_assert(sizeof(Slot) == sizeof(T), "CreateN needs T at least as large as a pointer");
+        if (count == 0) {
+            return nullptr;
+        }
+        Slot* slots = Bump(count);
+        std::size_t built = 0;
+        try {
+            for (; built < count; built++) {
+                Construct(slots + built, arg);
+            }
+        } catch (...) {
+            for (std::size_t i = 0; i < built; i++) {
+                Destroy(Object(slots + i));
+            }
+            for (std::size_t i = built; i < count; i++) {
+                Release(slots + i);
+            }
+            throw;
+        }
+        return Object(slots);
+    }
+
+    void Destroy(T* obj) {
+        Slot* slot = reinterpret_cast<Slot*>(obj);
+        obj->~T();
+        Chunk& chunk = ChunkOf(slot);
+        std::size_t index = slot - chunk.slots.get();
+        chunk.alive[index / 64] &= ~(std::uint64_t(1) << (index % 64));
+        Release(slot);
+    }
+
+    // разрушить все живые объекты; память остается в пуле для следующих Create
+    void DestroyAll() {
+        for (Chunk& chunk : chunks_) {
+            for (std::size_t word = 0; word * 64 < chunk.used; word++) {
+                std::uint64_t alive = chunk.alive[word];
+                chunk.alive[word] = 0;
+                if constexpr (!std::is_trivially_destructible<T>::value) {
+                    // только установленные биты: после Destroy карта бывает разреженной
+                    for (; alive != 0; alive &= alive - 1) {
+                        Object(&chunk.slots[word * 64 + __builtin_ctzll(alive)])->~T();
+                    }
+                }
+            }
+            chunk.used = 0;
+        }
+        current_ = 0;
+        free_ = nullptr;
+    }
+
+private:
+    union Slot {
+        typename std::aligned_storage<sizeof(T), alignof(T)>::type storage;
+        Slot* next;
+    };
+
+    struct Chunk {
+        std::unique_ptr<Slot[]> slots;
+        std::unique_ptr<std::uint64_t[]> alive;
+        std::size_t size;
+        std::size_t used;
+    };
+
+    const static std::size_t kChunk = 4096;
+
+    static T* Object(Slot* slot) {
+        return reinterpret_cast<T*>(&slot->storage);
+    }
+
+    void Release(Slot* slot) {
+        slot->next = free_;
+        free_ = slot;
+    }
+
+    template<typename U>
+    T* Construct(Slot* slot, const U& arg) {
+        T* obj = ::Create(&slot->storage, arg, Type2Type<T>());
+        Chunk& chunk = ChunkOf(slot);
+        std::size_t index = slot - chunk.slots.get();
+        chunk.alive[index / 64] |= std::uint64_t(1) << (index % 64);
+        return obj;
+    }
+
+    // кусок, в котором лежит слот: последний из начинающихся не позже него
+    Chunk& ChunkOf(Slot* slot) {
+        if (chunks_[current_].slots.get() <= slot && slot < chunks_[current_].slots.get() + chunks_[current_].size) {
+            return chunks_[current_];
+        }
+        return chunks_[std::prev(by_address_.upper_bound(slot))->second];
+    }
+
+    Slot* Bump(std::size_t count) {
+        while (current_ < chunks_.size() && chunks_[current_].used + count > chunks_[current_].size) {
+            ++current_;
+        }
+        if (current_ == chunks_.size()) {
+            std::size_t size = count > kChunk ? count : kChunk;
+            chunks_.push_back({std::unique_ptr<Slot[]>(new Slot[size]),
+                               std::unique_ptr<std::uint64_t[]>(new std::uint64_t[(size + 63) / 64]()), size, 0});
+            by_address_[chunks_.back().slots.get()] = current_;
+        }
+        Chunk& chunk = chunks_[current_];
+        Slot* slots = &chunk.slots[chunk.used];
+        chunk.used += count;
+        return slots;
+    }
+
+    std::vector<Chunk> chunks_;
+    std::map<const Slot*, std::size_t> by_address_;
+    std::size_t current_ = 0;
+    Slot* free_ = nullptr;
+};
+
+// Pools<TList>: по пулу на каждый тип из списка (GenScatterHierarchy из Pool)
+template<typename TList>
+class Pools;
+
+template<>
+class Pools<NullType> {
+public:
+    void DestroyAll() {}
+};
+
+template<typename Head, typename Tail>
+class Pools<TypeList<Head, Tail>> : public Pool<Head>, public Pools<Tail> {
+public:
+    void DestroyAll() {
+        Pool<Head>::DestroyAll();
+        Pools<Tail>::DestroyAll();
+    }
+};
+
+template<typename TList>
+class Factory : private Pools<TList> {
+public:
+    template<typename T, typename U>
+    T* Create(const U& arg) {
+        return PoolOf<T>().Create(arg);
+    }
+
+    template<typename T, typename U>
+    T* CreateN(std::size_t count, const U& arg) {
+        return PoolOf<T>().CreateN(count, arg);
+    }
+
+    template<typename T>
+    void Destroy(T* obj) {
+        PoolOf<T>().Destroy(obj);
+    }
+
+    void DestroyAll() {
+        Pools<TList>::DestroyAll();
+    }
+
+    // создание по индексу типа во время выполнения: таблица создателей, индекс - IndexOf.
+    // Все типы списка должны создаваться из U; для type вне списка
+    // (например, IndexOf = -1 у чужого типа) возвращается nullptr
+    template<typename U>
+    void* Create(int type, const U& arg) {
+        if (type < 0 || type >= static_cast<int>(Length<TList>::length)) {
+            return nullptr;
+        }
+        return Creators<U>(std::make_index_sequence<Length<TList>::length>())[type](*this, arg);
+    }
+
+private:
+    template<typename T>
+    Pool<T>& PoolOf() {
+        static_assert(IndexOf<TList, T>::pos >= 0, "type is not produced by this factory");
+        return *this;
+    }
+
+    template<typename U>
+    using Creator = void* (*)(Factory&, const U&);
+
+    template<typename U, std::size_t... Is>
+    static const Creator<U>* Creators(std::index_sequence<Is...>) {
+        static const Creator<U> table[] = {&CreateErased<typename TypeAt<TList, Is>::TargetType, U>...};
+        return table;
+    }
+
+    template<typename T, typename U>
+    static void* CreateErased(Factory& factory, const U& arg) {
+        return factory.template Create<T>(arg);
+    }
+};
+
+// второй продукт, который тоже создается из int*
+class Gadget {
+public:
+    explicit Gadget(int* value) : value_(value) {}
+
+    int Value() const {
+        return *value_;
+    }
+
+private:
+    int* value_;
+};
+
+template<typename F>
+void Measure(const char* name, std::size_t count, F f) {
+    auto start = std::chrono::steady_clock::now();
+    f();
+    auto finish = std::chrono::steady_clock::now();
+    std::cout << name << ": " << std::chrono::duration<double, std::nano>(finish - start).count() / count
+              << " ns/object" << std::endl;
+}
+
+int main() {
+    typedef TypeList<Widget, TypeList<Gadget, NullType>> Products;
+
+    int value = 1;
+    int* ptr = &value;
+    Factory<Products> factory;
+
+    Widget* widget = factory.Create<Widget>(ptr);
+    Gadget* gadget = static_cast<Gadget*>(factory.Create(IndexOf<Products, Gadget>::pos, ptr));
+    std::cout << gadget->Value() << std::endl;
+    Gadget* gadgets = factory.CreateN<Gadget>(3, ptr);
+    std::cout << gadgets[2].Value() << std::endl;
+    factory.Destroy(widget);
+    factory.DestroyAll();
+
+    const std::size_t count = 1000000;
+    const int rounds = 10;
+
+    Measure("new / delete Widget", count * rounds, [&] {
+        std::vector<Widget*> widgets(count);
+        for (int round = 0; round < rounds; round++) {
+            for (std::size_t i = 0; i < count; i++) {
+                widgets[i] = new Widget(ptr, -1);
+            }
+            for (std::size_t i = 0; i < count; i++) {
+                delete widgets[i];
+            }
+        }
+    });
+    Measure("Factory Create / DestroyAll", count * rounds, [&] {
+        std::vector<Widget*> widgets(count);
+        for (int round = 0; round < rounds; round++) {
+            for (std::size_t i = 0; i < count; i++) {
+                widgets[i] = factory.Create<Widget>(ptr);
+            }
+            factory.DestroyAll();
+        }
+    });
+    Measure("Factory CreateN / DestroyAll", count * rounds, [&] {
+        for (int round = 0; round < rounds; round++) {
+            factory.CreateN<Widget>(count, ptr);
+            factory.DestroyAll();
+        }
+    });
+    return 0;
+}